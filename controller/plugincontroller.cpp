@@ -5,12 +5,25 @@
 #include "plugincontroller.h"
 #include "pluginloader.h"
 #include "appsmanager.h"
+#include "constants.h"
 
 #include <QtConcurrent>
+#include <QThreadPool>
+#include <QTimer>
 
 LauncherPluginController::LauncherPluginController(QObject *parent)
     : QObject (parent)
+    , m_searchDelayTimer(new QTimer(this))
+    , m_searchThreadPool(new QThreadPool(this))
+    , m_searchGeneration(0)
+    , m_shownGeneration(0)
 {
+    m_searchDelayTimer->setInterval(DLauncher::PLUGIN_SEARCH_DELAY_TIME);
+    m_searchDelayTimer->setSingleShot(true);
+
+    m_searchThreadPool->setMaxThreadCount(qMax(2, QThread::idealThreadCount() / 2));
+
+    connect(m_searchDelayTimer, &QTimer::timeout, this, &LauncherPluginController::startSearch);
 }
 
 void LauncherPluginController::itemAdded(PluginInterface * const interface, const AppInfo &info)
@@ -85,22 +98,79 @@ void LauncherPluginController::initPlugin(PluginInterface *interface)
     interface->init(this);
 }
 
+/**
+ * @brief LauncherPluginController::onSearchedTextChanged 搜索内容变化后延时发起插件搜索, 连续输入时只搜索最后的内容
+ * @param keyword 搜索内容
+ */
 void LauncherPluginController::onSearchedTextChanged(const QString &keyword)
 {
-    if (keyword.isEmpty())
+    m_searchKeyword = keyword;
+
+    // 进行中的搜索结果全部作废, 之前的结果继续显示, 新的结果返回时再替换, 避免输入时结果区域闪烁
+    ++m_searchGeneration;
+
+    if (keyword.isEmpty()) {
+        m_searchDelayTimer->stop();
+        m_shownGeneration = m_searchGeneration;
+        AppsManager::instance()->clearSearchedData();
         return;
+    }
+
+    m_searchDelayTimer->start();
+}
+
+/**
+ * @brief LauncherPluginController::startSearch 所有插件并行搜索, 各自的结果返回后立即合并显示
+ */
+void LauncherPluginController::startSearch()
+{
+    for (PluginInterface *interface : m_pluginAppInterList) {
+        // 插件仍在执行上一次的搜索时, 等其结束后再搜索最新的内容
+        if (!m_busyPlugins.contains(interface))
+            searchPlugin(interface);
+    }
+}
+
+void LauncherPluginController::searchPlugin(PluginInterface *interface)
+{
+    const quint64 generation = m_searchGeneration;
+    const QString keyword = m_searchKeyword;
+
+    m_busyPlugins.insert(interface);
+
+    // 超时后丢弃该插件本次的结果, 插件线程无法中断, 仍由 watcher 等待其结束
+    QSharedPointer<bool> timedOut(new bool(false));
+    QTimer::singleShot(DLauncher::PLUGIN_SEARCH_TIMEOUT, this, [ = ] {
+        if (m_busyPlugins.contains(interface) && generation == m_searchGeneration) {
+            *timedOut = true;
+            qWarning() << "plugin search timeout:" << interface->pluginName() << keyword;
+        }
+    });
 
     QFutureWatcher<AppInfoList> *watcher = new QFutureWatcher<AppInfoList>(this);
-    connect(watcher, &QFutureWatcher<AppInfoList>::finished, this, [ watcher ]() {
-        const AppInfoList data = watcher->result();
-        AppsManager::instance()->showSearchedData(data);
+    connect(watcher, &QFutureWatcher<AppInfoList>::finished, this, [ = ] {
+        m_busyPlugins.remove(interface);
         watcher->deleteLater();
+
+        if (generation != m_searchGeneration) {
+            // 结果已过期, 搜索内容仍有效时用最新的内容重新搜索
+            if (!m_searchKeyword.isEmpty() && !m_searchDelayTimer->isActive())
+                searchPlugin(interface);
+
+            return;
+        }
+
+        // 本次搜索的第一个插件返回时清除之前的结果
+        if (m_shownGeneration != generation) {
+            m_shownGeneration = generation;
+            AppsManager::instance()->clearSearchedData();
+        }
+
+        if (!*timedOut)
+            AppsManager::instance()->appendSearchedData(watcher->result());
     });
-    QFuture<AppInfoList> future = QtConcurrent::run([ & ]() {
-            foreach (PluginInterface *inter, m_pluginAppInterList) {
-                return inter->search(keyword);
-            }
-         return AppInfoList();
-    });
-    watcher->setFuture(future);
+
+    watcher->setFuture(QtConcurrent::run(m_searchThreadPool, [ interface, keyword ] {
+        return interface->search(keyword);
+    }));
 }
@@ -9,6 +9,11 @@
 #include "pluginproxyinterface.h"
 #include "common.h"
 
+#include <QSet>
+
+class QThreadPool;
+class QTimer;
+
 class LauncherPluginController : public QObject, public PluginProxyInterface
 {
     Q_OBJECT
@@ -33,9 +38,20 @@ public Q_SLOTS:
 protected Q_SLOTS:
     void loadPlugin(const QString &pluginFile);
     void initPlugin(PluginInterface *interface);
+    void startSearch();
+
+private:
+    void searchPlugin(PluginInterface *interface);
 
 private:
     QList<PluginInterface *> m_pluginAppInterList;
+
+    QTimer *m_searchDelayTimer;                         // 输入防抖
+    QThreadPool *m_searchThreadPool;                    // 插件搜索专用线程, 避免慢插件占用全局线程池
+    QString m_searchKeyword;
+    quint64 m_searchGeneration;                         // 每次搜索的编号, 结果返回时编号已变化则丢弃
+    quint64 m_shownGeneration;                          // 当前显示的结果所属的搜索编号
+    QSet<PluginInterface *> m_busyPlugins;              // 正在搜索的插件, 同一插件同时只执行一个搜索
 };
 
 #endif
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundcache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QImage>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+/**
+ * @brief BackgroundCache::cacheDir 缓存目录
+ * @return ~/.cache/dde-launcher/backgrounds
+ */
+QString BackgroundCache::cacheDir()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/dde-launcher/backgrounds";
+}
+
+/**
+ * @brief BackgroundCache::wallpaperId 生成缓存的标识, 壁纸文件被替换或修改、屏幕分辨率或缩放变化后标识随之变化
+ * 显示器名称后使用显示器名称中不会出现的 '@' 分隔, 避免 "DP-1" 与 "DP-1-1" 等名称的缓存互相匹配
+ * @param workspace 工作区
+ * @param output 显示器名称
+ * @param wallpaper 壁纸文件路径
+ * @param size 背景的像素大小, 即屏幕大小乘以缩放比例
+ * @return 缓存的标识
+ */
+QString BackgroundCache::wallpaperId(int workspace, const QString &output, const QString &wallpaper, const QSize &size)
+{
+    const QFileInfo info(wallpaper);
+    const QString source = QString("%1:%2:%3:%4x%5").arg(wallpaper).arg(info.lastModified().toMSecsSinceEpoch()).arg(info.size())
+            .arg(size.width()).arg(size.height());
+    const QByteArray hash = QCryptographicHash::hash(source.toUtf8(), QCryptographicHash::Sha1).toHex().left(16);
+
+    return QString("%1-%2@%3").arg(workspace).arg(output).arg(QString::fromLatin1(hash));
+}
+
+QString BackgroundCache::fileName(const QString &wallpaperId, Kind kind)
+{
+    return QString("%1/%2-%3.jpg").arg(cacheDir()).arg(wallpaperId).arg(kind == Background ? "normal" : "blur");
+}
+
+/**
+ * @brief BackgroundCache::contains 该壁纸的全屏背景和模糊背景是否都已缓存
+ */
+bool BackgroundCache::contains(const QString &wallpaperId)
+{
+    return QFile::exists(fileName(wallpaperId, Background)) && QFile::exists(fileName(wallpaperId, BlurBackground));
+}
+
+/**
+ * @brief BackgroundCache::save 写入缓存, 先写临时文件再替换, 避免读取到不完整的图片
+ * @param fileName 缓存文件路径
+ * @param image 处理后的背景图片
+ * @return 是否写入成功
+ */
+bool BackgroundCache::save(const QString &fileName, const QImage &image)
+{
+    if (image.isNull() || !QDir().mkpath(cacheDir()))
+        return false;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) || !image.save(&file, "JPG", 95)) {
+        qWarning() << "failed to write background cache:" << fileName;
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
+
+/**
+ * @brief BackgroundCache::removeOutdated 删除该工作区及显示器之前的壁纸的缓存
+ * @param workspace 工作区
+ * @param output 显示器名称
+ * @param wallpaperId 当前壁纸的缓存标识, 不删除
+ */
+void BackgroundCache::removeOutdated(int workspace, const QString &output, const QString &wallpaperId)
+{
+    QDir dir(cacheDir());
+    const QStringList nameFilters = { QString("%1-%2@*.jpg").arg(workspace).arg(output) };
+    for (const QString &name : dir.entryList(nameFilters, QDir::Files)) {
+        if (!name.startsWith(wallpaperId + "-"))
+            dir.remove(name);
+    }
+}
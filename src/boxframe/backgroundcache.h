@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDCACHE_H
+#define BACKGROUNDCACHE_H
+
+#include <QString>
+#include <QSize>
+
+class QImage;
+
+/**处理后的背景图片的磁盘缓存
+ * 按 (工作区, 显示器, 壁纸, 屏幕像素大小, 类型) 保存已缩放至屏幕大小、经过模糊等处理的背景图片,
+ * 启动时直接使用缓存绘制背景, 壁纸变化后才重新通过 DBus 处理
+ * @brief The BackgroundCache class
+ */
+class BackgroundCache
+{
+public:
+    enum Kind {
+        Background,             // 全屏背景
+        BlurBackground,         // 模糊背景
+    };
+
+    static QString cacheDir();
+    static QString wallpaperId(int workspace, const QString &output, const QString &wallpaper, const QSize &size);
+    static QString fileName(const QString &wallpaperId, Kind kind);
+    static bool contains(const QString &wallpaperId);
+    static bool save(const QString &fileName, const QImage &image);
+    static void removeOutdated(int workspace, const QString &output, const QString &wallpaperId);
+};
+
+#endif // BACKGROUNDCACHE_H
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundimageloader.h"
+#include "backgroundcache.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QImageReader>
+#include <QtConcurrent>
+
+// 缓存的背景图片个数, 全屏大小的图片占用内存较多, 只保留最近使用的几张
+static const int MaxCachedBackgrounds = 3;
+
+BackgroundImageLoader::BackgroundImageLoader(QObject *parent)
+    : QObject(parent)
+    , m_cache(MaxCachedBackgrounds)
+    , m_serial(0)
+{
+}
+
+/**
+ * @brief BackgroundImageLoader::load 加载并缩放背景图片, 已缓存时立即返回, 否则在后台线程中加载完成后返回
+ * @param fileName 图片路径
+ * @param fallbackFileName 图片无法读取时使用的图片路径
+ * @param size 目标大小(像素), 图片按比例缩放至铺满该大小
+ * @param ratio 屏幕缩放比例
+ * @param cacheFileName 不为空时, 缩放后的图片同时写入该磁盘缓存文件, 下次启动时直接使用
+ */
+void BackgroundImageLoader::load(const QString &fileName, const QString &fallbackFileName, const QSize &size, qreal ratio,
+                                 const QString &cacheFileName)
+{
+    const QString key = cacheKey(fileName, size, ratio);
+    if (QPixmap *pixmap = m_cache.object(key)) {
+        ++m_serial;
+        m_pendingKey.clear();
+        emit loaded(*pixmap);
+        return;
+    }
+
+    if (key == m_pendingKey)
+        return;
+
+    m_pendingKey = key;
+    const int serial = ++m_serial;
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [ this, watcher, key, serial ] {
+        watcher->deleteLater();
+
+        const QImage image = watcher->result();
+        if (image.isNull()) {
+            // 读取失败时允许之后相同的请求重新加载
+            if (serial == m_serial)
+                m_pendingKey.clear();
+
+            return;
+        }
+
+        // 已被之后的请求替代的结果同样缓存, 切换回该壁纸时直接使用
+        const QPixmap pixmap = QPixmap::fromImage(image);
+        m_cache.insert(key, new QPixmap(pixmap));
+
+        if (serial != m_serial)
+            return;
+
+        m_pendingKey.clear();
+        emit loaded(pixmap);
+    });
+
+    watcher->setFuture(QtConcurrent::run([ fileName, fallbackFileName, size, cacheFileName ] {
+        QImage image = read(fileName, size);
+        if (image.isNull())
+            return read(fallbackFileName, size);
+
+        if (!cacheFileName.isEmpty())
+            BackgroundCache::save(cacheFileName, image);
+
+        return image;
+    }));
+}
+
+/**
+ * @brief BackgroundImageLoader::read 读取图片并按比例缩放至铺满目标大小
+ * 图片大于目标大小时直接以缩小后的分辨率解码(JPEG 按比例解码), 不再先解码完整分辨率的图片
+ * @param fileName 图片路径
+ * @param size 目标大小, 为空时不缩放
+ * @return 缩放后的图片, 读取失败时返回空图片
+ */
+QImage BackgroundImageLoader::read(const QString &fileName, const QSize &size)
+{
+    QImageReader reader(fileName);
+    const QSize imageSize = reader.size();
+
+    QSize targetSize;
+    if (imageSize.isValid() && !size.isEmpty())
+        targetSize = imageSize.scaled(size, Qt::KeepAspectRatioByExpanding);
+
+    if (targetSize.isValid() && targetSize.width() < imageSize.width())
+        reader.setScaledSize(targetSize);
+
+    QImage image = reader.read();
+    if (image.isNull() || size.isEmpty())
+        return image;
+
+    // 读取前无法获取大小的格式、不支持解码时缩放的格式以及小于目标大小的图片, 解码后再缩放
+    if (!targetSize.isValid())
+        targetSize = image.size().scaled(size, Qt::KeepAspectRatioByExpanding);
+
+    if (image.size() != targetSize)
+        image = image.scaled(targetSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+QString BackgroundImageLoader::cacheKey(const QString &fileName, const QSize &size, qreal ratio)
+{
+    const qint64 modifiedTime = QFileInfo(fileName).lastModified().toMSecsSinceEpoch();
+
+    return QString("%1:%2:%3x%4@%5").arg(fileName).arg(modifiedTime).arg(size.width()).arg(size.height()).arg(ratio);
+}
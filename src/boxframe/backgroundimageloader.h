@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef BACKGROUNDIMAGELOADER_H
+#define BACKGROUNDIMAGELOADER_H
+
+#include <QObject>
+#include <QCache>
+#include <QImage>
+#include <QPixmap>
+
+/**背景图片加载
+ * 按屏幕大小直接以较低的分辨率解码壁纸, 解码和缩放在后台线程中完成, 完成后通过 loaded 信号返回
+ * 结果按 (路径, 修改时间, 目标大小, 缩放比例) 缓存, 切换回之前的壁纸或屏幕时直接使用
+ * 加载过程中界面继续显示之前的图片, 只有最后一次请求的结果会被返回
+ * @brief The BackgroundImageLoader class
+ */
+class BackgroundImageLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit BackgroundImageLoader(QObject *parent = nullptr);
+
+    void load(const QString &fileName, const QString &fallbackFileName, const QSize &size, qreal ratio,
+              const QString &cacheFileName = QString());
+
+    static QImage read(const QString &fileName, const QSize &size);
+
+signals:
+    void loaded(const QPixmap &pixmap);
+
+private:
+    static QString cacheKey(const QString &fileName, const QSize &size, qreal ratio);
+
+private:
+    QCache<QString, QPixmap> m_cache;
+    QString m_pendingKey;                               // 正在加载的图片, 相同的请求不再重复加载
+    int m_serial;                                       // 请求序号, 丢弃已被之后的请求替代的结果
+};
+
+#endif // BACKGROUNDIMAGELOADER_H
@@ -3,9 +3,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "backgroundmanager.h"
+#include "backgroundcache.h"
 #include "appsmanager.h"
 
 #include <QApplication>
+#include <QTimer>
 #include <QtConcurrent>
 
 using namespace com::deepin;
@@ -46,8 +48,14 @@ BackgroundManager::BackgroundManager(QObject *parent)
     m_appearanceInter->setSync(false, false);
 
     m_displayMode = m_displayInter->GetRealDisplayMode();
+    m_currentWorkspace = m_wmInter->GetCurrentWorkspace();
 
-    connect(m_wmInter, &__wm::WorkspaceSwitched, this, &BackgroundManager::updateBlurBackgrounds);
+    connect(m_wmInter, &__wm::WorkspaceSwitched, this, [ this ](int from, int to) {
+        Q_UNUSED(from);
+
+        m_currentWorkspace = to;
+        updateBlurBackgrounds();
+    });
     connect(m_wmInter, &__wm::WorkspaceBackgroundChanged, this, &BackgroundManager::updateBlurBackgrounds);
     connect(m_appearanceInter, &AppearanceInter::Changed, this, &BackgroundManager::onAppearanceChanged);
     connect(m_displayInter, &DisplayInter::DisplayModeChanged, this, &BackgroundManager::onDisplayModeChanged);
@@ -62,9 +70,14 @@ BackgroundManager::BackgroundManager(QObject *parent)
 void BackgroundManager::getImageDataFromDbus(const QString &filePath)
 {
     // 异步获取模糊以及pixmix算法处理后的桌面背景(分类模式的视图背景)
+    // 处理完成前壁纸已经变化时丢弃结果, 避免之前壁纸的背景写入当前壁纸的缓存
+    const QString wallpaperId = m_wallpaperId;
     QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-    connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
+    connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher, wallpaperId]{
         imageEffectWatcher->deleteLater();
+        if (wallpaperId != m_wallpaperId)
+            return;
+
         m_blurBackground = imageEffectWatcher->result();
         if (!m_blurBackground.isEmpty())
             emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
@@ -90,8 +103,11 @@ void BackgroundManager::getImageDataFromDbus(const QString &filePath)
 
     // 异步获取全屏桌面背景
     QFutureWatcher<QString> *effectInterWatcher = new QFutureWatcher<QString> (this);
-    connect(effectInterWatcher, &QFutureWatcher<QString>::finished, this, [this, effectInterWatcher](){
+    connect(effectInterWatcher, &QFutureWatcher<QString>::finished, this, [this, effectInterWatcher, wallpaperId](){
         effectInterWatcher->deleteLater();
+        if (wallpaperId != m_wallpaperId)
+            return;
+
         m_background = effectInterWatcher->result();
         if (!m_background.isEmpty())
             emit currentWorkspaceBackgroundChanged(m_background);
@@ -113,7 +129,7 @@ void BackgroundManager::getImageDataFromDbus(const QString &filePath)
 
 void BackgroundManager::updateBlurBackgrounds()
 {
-    QString screenName = AppsManager::instance()->currentScreen()->name();
+    const QScreen *screen = AppsManager::instance()->currentScreen();
 
     if (m_displayMode != MERGE_MODE) {
         QWidget *parentWidget =qobject_cast<QWidget *>(parent());
@@ -122,9 +138,11 @@ void BackgroundManager::updateBlurBackgrounds()
         QList<QScreen *> screens = qApp->screens();
 
         if (screenIndex != -1)
-            screenName = screens[screenIndex]->name();
+            screen = screens[screenIndex];
     }
 
+    const QString screenName = screen->name();
+
     QDBusMessage message = QDBusMessage::createMethodCall("org.deepin.dde.Appearance1", "/org/deepin/dde/Appearance1", "org.deepin.dde.Appearance1", "GetCurrentWorkspaceBackgroundForMonitor");
     message << screenName;
 
@@ -133,6 +151,32 @@ void BackgroundManager::updateBlurBackgrounds()
     QString path = getLocalFile(result.value());
     m_fileName = QFile::exists(path) ? path : DefaultWallpaper;
 
+    const QString wallpaperId = BackgroundCache::wallpaperId(m_currentWorkspace, screenName, m_fileName,
+                                                             screen->size() * screen->devicePixelRatio());
+
+    // 壁纸没有变化且已获取背景, 或同一壁纸正在或已经通过 DBus 处理过时, 不再重复处理
+    if (wallpaperId == m_wallpaperId && (wallpaperId == m_processingId || (!m_background.isEmpty() && !m_blurBackground.isEmpty())))
+        return;
+
+    m_wallpaperId = wallpaperId;
+
+    // 磁盘中已有该壁纸处理后的背景时直接使用, 不再通过 DBus 重新处理
+    // 构造时信号尚未连接, 下一次事件循环时再通知
+    if (BackgroundCache::contains(m_wallpaperId)) {
+        m_background = BackgroundCache::fileName(m_wallpaperId, BackgroundCache::Background);
+        m_blurBackground = BackgroundCache::fileName(m_wallpaperId, BackgroundCache::BlurBackground);
+        QTimer::singleShot(0, this, [ this, wallpaperId ] {
+            if (wallpaperId != m_wallpaperId)
+                return;
+
+            emit currentWorkspaceBackgroundChanged(m_background);
+            emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
+        });
+        return;
+    }
+
+    BackgroundCache::removeOutdated(m_currentWorkspace, screenName, m_wallpaperId);
+    m_processingId = m_wallpaperId;
     getImageDataFromDbus(m_fileName);
 }
 
@@ -170,9 +214,13 @@ void BackgroundManager::onGetBlurImageFromDbus(const QString &file, const QStrin
     // 信号返回的文件路径与本地获取的文件路径比对
     if (status && file == m_fileName) {
         // 异步获取pixmix处理模糊后的背景(分类模式的视图背景)
+        const QString wallpaperId = m_wallpaperId;
         QFutureWatcher<QString> *imageEffectWatcher = new QFutureWatcher<QString>(this);
-        connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher]{
+        connect(imageEffectWatcher, &QFutureWatcher<QString>::finished, this, [this, imageEffectWatcher, wallpaperId]{
             imageEffectWatcher->deleteLater();
+            if (wallpaperId != m_wallpaperId)
+                return;
+
             m_blurBackground = imageEffectWatcher->result();
             if (!m_blurBackground.isEmpty())
                 emit currentWorkspaceBlurBackgroundChanged(m_blurBackground);
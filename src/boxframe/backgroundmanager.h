@@ -53,6 +53,7 @@ public:
     explicit BackgroundManager(QObject *parent = nullptr);
 
     int dispalyMode() const { return m_displayMode; }
+    QString wallpaperId() const { return m_wallpaperId; }
 
 private:
     void getImageDataFromDbus(const QString &filePath);
@@ -81,6 +82,8 @@ private:
     QPointer<DisplayInter> m_displayInter;
     int m_displayMode;
     QString m_fileName;
+    QString m_wallpaperId;                              // 当前壁纸的缓存标识, 见 BackgroundCache::wallpaperId
+    QString m_processingId;                             // 已经通过 DBus 处理过的壁纸的缓存标识, 同一标识只处理一次
 };
 
 #endif // BACKGROUNDMANAGER_H
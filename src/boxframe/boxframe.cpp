@@ -4,6 +4,8 @@
 
 #include "boxframe.h"
 #include "backgroundmanager.h"
+#include "backgroundimageloader.h"
+#include "backgroundcache.h"
 #include "util.h"
 #include "constants.h"
 
@@ -14,6 +16,23 @@
 #include <QScreen>
 #include <QPainter>
 #include <QPaintEvent>
+#include <QImageReader>
+
+/**
+ * @brief backgroundCacheFile 获取加载背景后需要写入的磁盘缓存文件
+ * @param bgManager 背景管理
+ * @param url 加载的背景图片
+ * @param kind 背景的类型
+ * @return 缓存文件路径, 加载的就是缓存文件时返回空
+ */
+static QString backgroundCacheFile(BackgroundManager *bgManager, const QString &url, BackgroundCache::Kind kind)
+{
+    if (bgManager->wallpaperId().isEmpty())
+        return QString();
+
+    const QString fileName = BackgroundCache::fileName(bgManager->wallpaperId(), kind);
+    return url == fileName ? QString() : fileName;
+}
 
 /**
  * @brief BoxFrame::BoxFrame 桌面背景类
@@ -23,12 +42,23 @@ BoxFrame::BoxFrame(QWidget *parent)
     : QLabel(parent)
     , m_defaultBg("/usr/share/backgrounds/default_background.jpg")
     , m_bgManager(nullptr)
+    , m_bgLoader(nullptr)
+    , m_blurBgLoader(nullptr)
     , m_useSolidBackground(false)
 {
     m_useSolidBackground = ConfigWorker::getValue(DLauncher::USE_SOLID_BACKGROUND, false).toBool();
     if (m_useSolidBackground)
         return;
 
+    // 壁纸在后台线程中解码和缩放, 完成前继续显示之前的背景
+    m_bgLoader = new BackgroundImageLoader(this);
+    m_blurBgLoader = new BackgroundImageLoader(this);
+    connect(m_bgLoader, &BackgroundImageLoader::loaded, this, [ this ](const QPixmap &pixmap) {
+        m_pixmap = pixmap;
+        update();
+    });
+    connect(m_blurBgLoader, &BackgroundImageLoader::loaded, this, &BoxFrame::backgroundImageChanged);
+
     m_bgManager = new BackgroundManager(this);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBackgroundChanged, this, &BoxFrame::setBackground);
     connect(m_bgManager, &BackgroundManager::currentWorkspaceBlurBackgroundChanged, this, &BoxFrame::setBlurBackground);
@@ -54,7 +84,7 @@ void BoxFrame::setBlurBackground(const QString &url)
     scaledBlurBackground();
 }
 
-/** 缩放图片并缓存
+/** 缩放图片并缓存, 加载完成后通过 backgroundImageChanged 信号更新模糊背景
  * @brief BoxFrame::scaledBlurBackground
  */
 void BoxFrame::scaledBlurBackground()
@@ -62,27 +92,15 @@ void BoxFrame::scaledBlurBackground()
     if (m_useSolidBackground)
         return;
 
-    const QSize &size = currentScreen()->size() * currentScreen()->devicePixelRatio();
-    static QString blurBgPath;
-    static QSize lastSize;
+    // 背景图片路径及屏幕大小没有变化时直接使用加载过的图片
+    const qreal ratio = currentScreen()->devicePixelRatio();
+    const QSize &size = currentScreen()->size() * ratio;
 
-    // 当背景图片路径且屏幕大小没有变化，则无需再次加载,减少资源加载耗时
-    if (blurBgPath == m_lastBlurUrl && size == lastSize)
-        return;
-
-    blurBgPath = m_lastBlurUrl;
-    lastSize = size;
-
-    QPixmap pixmap(m_lastBlurUrl);
-    if (pixmap.isNull())
-        pixmap.load(m_defaultBg);
-
-    QPixmap scaledpixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                                         Qt::SmoothTransformation);
-    emit backgroundImageChanged(scaledpixmap);
+    m_blurBgLoader->load(m_lastBlurUrl, m_defaultBg, size, ratio,
+                         backgroundCacheFile(m_bgManager, m_lastBlurUrl, BackgroundCache::BlurBackground));
 }
 
-/** 缩放图片并缓存
+/** 缩放图片并缓存, 加载完成后更新背景
  * @brief BoxFrame::scaledBackground
  */
 void BoxFrame::scaledBackground()
@@ -90,24 +108,20 @@ void BoxFrame::scaledBackground()
     if (m_useSolidBackground)
         return;
 
-    // 当背景图片路径且屏幕大小没有变化，则无需再次加载,减少资源加载耗时
-    const QSize &size = currentScreen()->size() * currentScreen()->devicePixelRatio();
-    static QString bgPath;
-    static QSize lastSize;
+    // 背景图片路径及屏幕大小没有变化时直接使用加载过的图片
+    const qreal ratio = currentScreen()->devicePixelRatio();
+    const QSize &size = currentScreen()->size() * ratio;
 
-    if (bgPath == m_lastUrl && lastSize == size)
-        return;
+    m_bgLoader->load(m_lastUrl, m_defaultBg, size, ratio,
+                     backgroundCacheFile(m_bgManager, m_lastUrl, BackgroundCache::Background));
 
-    bgPath = m_lastUrl;
-    lastSize = size;
-
-    QPixmap pixmap(m_lastUrl);
-    if (pixmap.isNull())
-        pixmap = QPixmap(m_defaultBg);
-
-    m_pixmap = pixmap.scaled(size, Qt::KeepAspectRatioByExpanding,
-                             Qt::SmoothTransformation);
-    update();
+    // 缓存的背景与当前屏幕大小不一致时(如分辨率变化), 先缩放缓存显示, 同时按新的屏幕大小重新获取全屏背景和模糊背景
+    // 缓存标识包含屏幕大小, 标识没有变化时不会重复处理
+    if (m_lastUrl == BackgroundCache::fileName(m_bgManager->wallpaperId(), BackgroundCache::Background)) {
+        const QSize cachedSize = QImageReader(m_lastUrl).size();
+        if (cachedSize.isValid() && cachedSize.scaled(size, Qt::KeepAspectRatioByExpanding) != cachedSize)
+            m_bgManager->updateBlurBackgrounds();
+    }
 }
 
 const QScreen *BoxFrame::currentScreen()
@@ -10,6 +10,7 @@
 
 class QPixmap;
 class BackgroundManager;
+class BackgroundImageLoader;
 class QScreen;
 
 class BoxFrame : public QLabel
@@ -42,6 +43,8 @@ private:
     QPixmapCache::Key m_cacheNormalKey;
     QPixmapCache::Key m_cacheBlurKey;
     BackgroundManager *m_bgManager;
+    BackgroundImageLoader *m_bgLoader;
+    BackgroundImageLoader *m_blurBgLoader;
     bool m_useSolidBackground;
 };
 
@@ -3,27 +3,15 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 
 #include "amdbusdockinterface.h"
+#include "dbuspropertymirror.h"
 
 class DockPrivate
 {
 public:
    DockPrivate() = default;
 
-    // begin member variables
-    int DisplayMode;
-    QStringList DockedApps;
-    QList<QDBusObjectPath> Entries;
-    QRect FrontendWindowRect;
-    int HideMode;
-    int HideState;
-    uint HideTimeout;
-    uint IconSize;
-    double Opacity;
-    int Position;
-    uint ShowTimeout;
-    uint WindowSize;
-    uint WindowSizeEfficient;
-    uint WindowSizeFashion;
+    // 属性的本地镜像, 读取属性时不再阻塞
+    DBusPropertyMirror *m_properties = nullptr;
 
 public:
     QMap<QString, QDBusPendingCallWatcher *> m_processingCalls;
@@ -34,6 +22,7 @@ AMDBusDockInter::AMDBusDockInter(QObject *parent)
     : QDBusAbstractInterface(INTERFACE_NAME, SERVICE_PATH, staticInterfaceName(), QDBusConnection::sessionBus(), parent)
     , d_ptr(new DockPrivate)
 {
+    d_ptr->m_properties = new DBusPropertyMirror(this);
     QDBusConnection::sessionBus().connect(service(), path(), "org.freedesktop.DBus.Properties", "PropertiesChanged","sa{sv}as", this, SLOT(onPropertyChanged(const QDBusMessage &)));
 }
 
@@ -46,29 +35,12 @@ AMDBusDockInter::~AMDBusDockInter()
 
 void AMDBusDockInter::onPropertyChanged(const QDBusMessage& msg)
 {
-    QList<QVariant> arguments = msg.arguments();
-    if (3 != arguments.count())
-        return;
-
-    QString interfaceName = msg.arguments().at(0).toString();
-    if (interfaceName != staticInterfaceName())
-        return;
-
-    QVariantMap changedProps = qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>());
-    QStringList keys = changedProps.keys();
-    foreach(const QString &prop, keys) {
-        const QMetaObject *self = metaObject();
-        for (int i = self->propertyOffset(); i < self->propertyCount(); ++i) {
-            QMetaProperty property = self->property(i);
-            if (property.name() == prop)
-                Q_EMIT property.notifySignal().invoke(this);
-        }
-    }
+    d_ptr->m_properties->onPropertiesChanged(msg);
 }
 
 int AMDBusDockInter::displayMode()
 {
-    return qvariant_cast<int>(property("DisplayMode"));
+    return d_ptr->m_properties->get<int>("DisplayMode");
 }
 
 void AMDBusDockInter::setDisplayMode(int value)
@@ -78,22 +50,22 @@ void AMDBusDockInter::setDisplayMode(int value)
 
 QStringList AMDBusDockInter::dockedApps()
 {
-    return qvariant_cast<QStringList>(property("DockedApps"));
+    return d_ptr->m_properties->get<QStringList>("DockedApps");
 }
 
 QList<QDBusObjectPath> AMDBusDockInter::entries()
 {
-    return qvariant_cast<QList<QDBusObjectPath>>(property("Entries"));
+    return d_ptr->m_properties->get<QList<QDBusObjectPath>>("Entries");
 }
 
 QRect AMDBusDockInter::frontendWindowRect()
 {
-    return qvariant_cast<QRect>(property("FrontendWindowRect"));
+    return d_ptr->m_properties->get<QRect>("FrontendWindowRect");
 }
 
 int AMDBusDockInter::hideMode()
 {
-    return qvariant_cast<int>(property("HideMode"));
+    return d_ptr->m_properties->get<int>("HideMode");
 }
 
 void AMDBusDockInter::setHideMode(int value)
@@ -104,12 +76,12 @@ void AMDBusDockInter::setHideMode(int value)
 
 int AMDBusDockInter::hideState()
 {
-    return qvariant_cast<int>(property("HideState"));
+    return d_ptr->m_properties->get<int>("HideState");
 }
 
 uint AMDBusDockInter::hideTimeout()
 {
-    return qvariant_cast<uint>(property("HideTimeout"));
+    return d_ptr->m_properties->get<uint>("HideTimeout");
 }
 
 void AMDBusDockInter::setHideTimeout(uint value)
@@ -120,7 +92,7 @@ void AMDBusDockInter::setHideTimeout(uint value)
 
 uint AMDBusDockInter::iconSize()
 {
-    return qvariant_cast<uint>(property("IconSize"));
+    return d_ptr->m_properties->get<uint>("IconSize");
 }
 
 void AMDBusDockInter::setIconSize(uint value)
@@ -131,7 +103,7 @@ void AMDBusDockInter::setIconSize(uint value)
 
 double AMDBusDockInter::opacity()
 {
-    return qvariant_cast<double>(property("Opacity"));
+    return d_ptr->m_properties->get<double>("Opacity");
 }
 
 void AMDBusDockInter::setOpacity(double value)
@@ -142,7 +114,7 @@ void AMDBusDockInter::setOpacity(double value)
 
 int AMDBusDockInter::position()
 {
-    return qvariant_cast<int>(property("Position"));
+    return d_ptr->m_properties->get<int>("Position");
 }
 
 void AMDBusDockInter::setPosition(int value)
@@ -152,7 +124,7 @@ void AMDBusDockInter::setPosition(int value)
 
 uint AMDBusDockInter::showTimeout()
 {
-    return qvariant_cast<uint>(property("ShowTimeout"));
+    return d_ptr->m_properties->get<uint>("ShowTimeout");
 }
 
 void AMDBusDockInter::setShowTimeout(uint value)
@@ -163,7 +135,7 @@ void AMDBusDockInter::setShowTimeout(uint value)
 
 uint AMDBusDockInter::windowSize()
 {
-    return qvariant_cast<uint>(property("WindowSize"));
+    return d_ptr->m_properties->get<uint>("WindowSize");
 }
 
 void AMDBusDockInter::setWindowSize(uint value)
@@ -173,7 +145,7 @@ void AMDBusDockInter::setWindowSize(uint value)
 
 uint AMDBusDockInter::windowSizeEfficient()
 {
-    return qvariant_cast<uint>(property("WindowSizeEfficient"));
+    return d_ptr->m_properties->get<uint>("WindowSizeEfficient");
 }
 
 void AMDBusDockInter::setWindowSizeEfficient(uint value)
@@ -184,7 +156,7 @@ void AMDBusDockInter::setWindowSizeEfficient(uint value)
 
 uint AMDBusDockInter::windowSizeFashion()
 {
-    return qvariant_cast<uint>(property("WindowSizeFashion"));
+    return d_ptr->m_properties->get<uint>("WindowSizeFashion");
 }
 
 void AMDBusDockInter::setWindowSizeFashion(uint value)
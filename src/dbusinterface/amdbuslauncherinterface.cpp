@@ -10,12 +10,15 @@
 
 AMDBusLauncherInter::AMDBusLauncherInter(QObject *parent)
     : QDBusAbstractInterface(INTERFACE_NAME, SERVICE_PATH, staticInterfaceName(), QDBusConnection::sessionBus(), parent)
+    , m_properties(nullptr)
 {
     CategoryInfo::registerMetaType();
     FrequencyInfo::registerMetaType();
     ItemInfo_v2::registerMetaType();
     InstalledTimeInfo::registerMetaType();
 
+    m_properties = new DBusPropertyMirror(this);
+
     QDBusConnection::sessionBus().connect(service(), path(), "org.freedesktop.DBus.Properties",  "PropertiesChanged","sa{sv}as", this, SLOT(__propertyChanged__(const QDBusMessage&)));
 }
 
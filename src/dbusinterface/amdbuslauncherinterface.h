@@ -9,6 +9,7 @@
 #include "frequencyinfo.h"
 #include "iteminfo.h"
 #include "installedtimeinfo.h"
+#include "dbuspropertymirror.h"
 
 #include <QObject>
 #include <QByteArray>
@@ -31,25 +32,9 @@ class AMDBusLauncherInter: public QDBusAbstractInterface
 
     Q_SLOT void __propertyChanged__(const QDBusMessage& msg)
     {
-        QList<QVariant> arguments = msg.arguments();
-        if (3 != arguments.count())
-            return;
-
-        QString interfaceName = msg.arguments().at(0).toString();
-        if (interfaceName != staticInterfaceName())
-            return;
-
-        QVariantMap changedProps = qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>());
-        foreach(const QString &prop, changedProps.keys()) {
-        const QMetaObject *self = metaObject();
-            for (int i = self->propertyOffset(); i < self->propertyCount(); ++i) {
-                const QMetaProperty property = self->property(i);
-                if (property.name() == prop) {
-                    Q_EMIT property.notifySignal().invoke(this);
-                }
-            }
-        }
-   }
+        m_properties->onPropertiesChanged(msg);
+    }
+
 public:
     static inline const char *staticInterfaceName()
     { return INTERFACE_NAME; }
@@ -61,11 +46,11 @@ public:
 
     Q_PROPERTY(bool Fullscreen READ fullscreen NOTIFY FullscreenChanged)
     inline bool fullscreen() const
-    { return qvariant_cast< bool >(property("Fullscreen")); }
+    { return m_properties->get<bool>("Fullscreen"); }
 
     Q_PROPERTY(int DisplayMode READ displaymode NOTIFY DisplayModeChanged)
     inline int displaymode() const
-    { return qvariant_cast< int >(property("DisplayMode")); }
+    { return m_properties->get<int>("DisplayMode"); }
 
 public Q_SLOTS: // METHODS
     inline QDBusPendingReply<CategoryInfoList> GetAllCategoryInfos()
@@ -210,6 +195,9 @@ public Q_SLOTS: // METHODS
 
        void FullscreenChanged();
        void DisplayModeChanged();
+
+private:
+    DBusPropertyMirror *m_properties;
 };
 
 #endif
@@ -17,7 +17,13 @@
 
 DBusDockInterface::DBusDockInterface(QObject *parent)
     : QDBusAbstractInterface(INTERFACE_NAME, SERVICE_PATH, staticInterfaceName(), QDBusConnection::sessionBus(), parent)
+    , m_properties(new DBusPropertyMirror(this))
 {
+    // 任务栏通过 geometryChanged 信号通知位置变化
+    connect(this, &DBusDockInterface::geometryChanged, this, [ this ](const QRect &rect) {
+        m_properties->setValue("geometry", rect);
+    });
+
     QDBusConnection::sessionBus().connect(this->service(), this->path(), "org.freedesktop.DBus.Properties", "PropertiesChanged","sa{sv}as", this, SLOT(__propertyChanged__(const QDBusMessage &)));
 }
 
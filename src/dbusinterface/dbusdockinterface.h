@@ -12,6 +12,7 @@
 #define DBUSDOCK_H
 
 #include "dockrect.h"
+#include "dbuspropertymirror.h"
 
 #include <QObject>
 #include <QByteArray>
@@ -34,25 +35,9 @@ class DBusDockInterface: public QDBusAbstractInterface
 
     Q_SLOT void __propertyChanged__(const QDBusMessage &msg)
     {
-        QList<QVariant> arguments = msg.arguments();
-        if (3 != arguments.count())
-            return;
-
-        QString interfaceName = msg.arguments().at(0).toString();
-        if (interfaceName != staticInterfaceName())
-            return;
+        m_properties->onPropertiesChanged(msg);
+    }
 
-        QVariantMap changedProps = qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>());
-        foreach(const QString &prop, changedProps.keys()) {
-            const QMetaObject *self = metaObject();
-            for (int i = self->propertyOffset(); i < self->propertyCount(); ++i) {
-                QMetaProperty property = self->property(i);
-                if (property.name() == prop) {
-                    Q_EMIT property.notifySignal().invoke(this);
-                }
-            }
-        }
-   }
 public:
     static inline const char *staticInterfaceName()
     { return INTERFACE_NAME; }
@@ -64,9 +49,12 @@ public:
     Q_PROPERTY(QRect geometry READ geometry)
     inline QRect geometry() const
     {
-        return qvariant_cast<QRect>(property("geometry"));
+        return m_properties->get<QRect>("geometry");
     }
 Q_SIGNALS: // SIGNALS
     void geometryChanged(const QRect &rect);
+
+private:
+    DBusPropertyMirror *m_properties;
 };
 #endif
@@ -0,0 +1,170 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dbuspropertymirror.h"
+
+#include <QDebug>
+#include <QDBusAbstractInterface>
+#include <QDBusArgument>
+#include <QDBusMetaType>
+#include <QDBusPendingCallWatcher>
+#include <QDBusPendingReply>
+#include <QDBusServiceWatcher>
+#include <QMetaProperty>
+
+static const QString PROPERTIES_INTERFACE = QStringLiteral("org.freedesktop.DBus.Properties");
+
+DBusPropertyMirror::DBusPropertyMirror(QDBusAbstractInterface *inter)
+    : QObject(inter)
+    , m_inter(inter)
+    , m_serviceWatcher(new QDBusServiceWatcher(inter->service(), inter->connection(), QDBusServiceWatcher::WatchForUnregistration, this))
+{
+    // 服务重启后属性可能在没有 PropertiesChanged 的情况下发生变化, 清空镜像后在读取时重新查询
+    connect(m_serviceWatcher, &QDBusServiceWatcher::serviceUnregistered, this, [ this ] {
+        m_properties.clear();
+    });
+
+    load();
+}
+
+/**
+ * @brief DBusPropertyMirror::value 读取镜像中的属性值, 镜像中没有该属性时(服务未启动或已退出)才向服务查询
+ * @param name 属性名称
+ * @return 属性值, 已转换为接口类中 Q_PROPERTY 声明的类型
+ */
+QVariant DBusPropertyMirror::value(const char *name) const
+{
+    const QString key = QString::fromLatin1(name);
+    auto it = m_properties.constFind(key);
+    if (it != m_properties.constEnd())
+        return it.value();
+
+    const QVariant value = m_inter->property(name);
+    if (value.isValid())
+        m_properties.insert(key, value);
+
+    return value;
+}
+
+/**
+ * @brief DBusPropertyMirror::setValue 服务通过自定义信号而不是 PropertiesChanged 通知属性变化时, 由接口类更新镜像
+ * @param name 属性名称
+ * @param value 属性的新值
+ */
+void DBusPropertyMirror::setValue(const char *name, const QVariant &value)
+{
+    m_properties.insert(QString::fromLatin1(name), value);
+}
+
+/**
+ * @brief DBusPropertyMirror::onPropertiesChanged 根据 PropertiesChanged 信号更新镜像, 并发出接口类中对应的属性变化信号
+ * @param msg PropertiesChanged 信号的消息
+ */
+void DBusPropertyMirror::onPropertiesChanged(const QDBusMessage &msg)
+{
+    const QList<QVariant> arguments = msg.arguments();
+    if (3 != arguments.count())
+        return;
+
+    if (arguments.at(0).toString() != m_inter->interface())
+        return;
+
+    const QVariantMap changedProps = qdbus_cast<QVariantMap>(arguments.at(1).value<QDBusArgument>());
+    for (auto it = changedProps.constBegin(); it != changedProps.constEnd(); ++it)
+        m_properties.insert(it.key(), toPropertyType(it.key(), it.value()));
+
+    // 只通知变化而不带新值的属性, 读取时重新查询
+    const QStringList invalidatedProps = qdbus_cast<QStringList>(arguments.at(2));
+    for (const QString &prop : invalidatedProps)
+        m_properties.remove(prop);
+
+    notifyPropertiesChanged(changedProps.keys() + invalidatedProps);
+}
+
+/**
+ * @brief DBusPropertyMirror::notifyPropertiesChanged 发出接口类中对应的属性变化信号
+ * @param names 发生变化的属性名称
+ */
+void DBusPropertyMirror::notifyPropertiesChanged(const QStringList &names)
+{
+    const QMetaObject *self = m_inter->metaObject();
+    for (int i = self->propertyOffset(); i < self->propertyCount(); ++i) {
+        const QMetaProperty property = self->property(i);
+        const QString name = QString::fromLatin1(property.name());
+        if (!names.contains(name))
+            continue;
+
+        const QMetaMethod notifySignal = property.notifySignal();
+        if (notifySignal.parameterCount() == 0) {
+            notifySignal.invoke(m_inter);
+            continue;
+        }
+
+        QVariant value = this->value(property.name());
+        if (!value.convert(property.userType()))
+            value = QVariant(property.userType(), nullptr);
+
+        notifySignal.invoke(m_inter, QGenericArgument(value.typeName(), value.constData()));
+    }
+}
+
+/**
+ * @brief DBusPropertyMirror::load 通过一次异步的 GetAll 读取接口的全部属性, 返回前读取的属性直接向服务查询
+ */
+void DBusPropertyMirror::load()
+{
+    QDBusMessage msg = QDBusMessage::createMethodCall(m_inter->service(), m_inter->path(), PROPERTIES_INTERFACE, QStringLiteral("GetAll"));
+    msg << m_inter->interface();
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_inter->connection().asyncCall(msg), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ this ](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        const QDBusPendingReply<QVariantMap> reply = *call;
+        if (reply.isError()) {
+            qWarning() << "get all properties failed, interface:" << m_inter->interface() << ", error:" << reply.error().message();
+            return;
+        }
+
+        // 同一服务的消息按顺序到达, 先于回复发出的 PropertiesChanged 已经包含在回复中
+        // 回复前未读取过或值已变化的属性通过属性变化信号通知, 使用者不必在创建时阻塞读取
+        QStringList changedNames;
+        const QVariantMap properties = reply.value();
+        for (auto it = properties.constBegin(); it != properties.constEnd(); ++it) {
+            const QVariant value = toPropertyType(it.key(), it.value());
+            auto old = m_properties.constFind(it.key());
+            if (old == m_properties.constEnd() || old.value() != value)
+                changedNames << it.key();
+
+            m_properties.insert(it.key(), value);
+        }
+
+        notifyPropertiesChanged(changedNames);
+    });
+}
+
+/**
+ * @brief DBusPropertyMirror::toPropertyType 将 D-Bus 返回的属性值转换为 Q_PROPERTY 声明的类型,
+ * 结构体及数组类型的属性以 QDBusArgument 返回, 需要反序列化
+ * @param name 属性名称
+ * @param value D-Bus 返回的属性值
+ * @return 转换后的属性值, 接口类中未声明该属性或无法转换时返回原值
+ */
+QVariant DBusPropertyMirror::toPropertyType(const QString &name, const QVariant &value) const
+{
+    if (value.userType() != qMetaTypeId<QDBusArgument>())
+        return value;
+
+    const QMetaObject *self = m_inter->metaObject();
+    const int index = self->indexOfProperty(name.toLatin1().constData());
+    if (index < self->propertyOffset())
+        return value;
+
+    const int typeId = self->property(index).userType();
+    QVariant result(typeId, nullptr);
+    if (!QDBusMetaType::demarshall(value.value<QDBusArgument>(), typeId, result.data()))
+        return value;
+
+    return result;
+}
@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DBUSPROPERTYMIRROR_H
+#define DBUSPROPERTYMIRROR_H
+
+#include <QObject>
+#include <QVariantMap>
+#include <QDBusMessage>
+
+class QDBusAbstractInterface;
+class QDBusServiceWatcher;
+
+/**D-Bus 属性的本地镜像
+ * 创建时通过一次异步的 GetAll 读取接口的全部属性, 之后由 PropertiesChanged 信号更新, 读取属性时不再阻塞等待 D-Bus 返回
+ * 服务退出后清空镜像, 再次读取时重新向服务查询
+ * @brief The DBusPropertyMirror class
+ */
+class DBusPropertyMirror : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit DBusPropertyMirror(QDBusAbstractInterface *inter);
+
+    QVariant value(const char *name) const;
+
+    template <typename T>
+    inline T get(const char *name) const
+    { return qvariant_cast<T>(value(name)); }
+
+    void setValue(const char *name, const QVariant &value);
+    void onPropertiesChanged(const QDBusMessage &msg);
+
+private:
+    void load();
+    void notifyPropertiesChanged(const QStringList &names);
+    QVariant toPropertyType(const QString &name, const QVariant &value) const;
+
+private:
+    QDBusAbstractInterface *m_inter;
+    QDBusServiceWatcher *m_serviceWatcher;
+    mutable QVariantMap m_properties;
+};
+
+#endif // DBUSPROPERTYMIRROR_H
@@ -0,0 +1,20 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "dbusproxyregistry.h"
+
+QPointer<DBusProxyRegistry> DBusProxyRegistry::INSTANCE = nullptr;
+
+DBusProxyRegistry *DBusProxyRegistry::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new DBusProxyRegistry;
+
+    return INSTANCE;
+}
+
+DBusProxyRegistry::DBusProxyRegistry(QObject *parent)
+    : QObject(parent)
+{
+}
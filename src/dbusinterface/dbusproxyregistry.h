@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DBUSPROXYREGISTRY_H
+#define DBUSPROXYREGISTRY_H
+
+#include <QObject>
+#include <QPointer>
+#include <QHash>
+#include <QDBusAbstractInterface>
+
+/**D-Bus 代理对象注册表
+ * 每个接口类对应固定的服务、路径及接口, 整个进程共享同一个代理对象, 只建立一次 PropertiesChanged 监听和属性镜像
+ * 代理对象在第一次获取时创建, 归注册表所有, 使用方不要删除
+ * @brief The DBusProxyRegistry class
+ */
+class DBusProxyRegistry : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DBusProxyRegistry *instance();
+
+    template <typename T>
+    T *proxy()
+    {
+        const QString key = QString::fromLatin1(T::staticInterfaceName());
+        QDBusAbstractInterface *inter = m_proxies.value(key);
+        if (!inter) {
+            inter = new T(this);
+            m_proxies.insert(key, inter);
+        }
+
+        return static_cast<T *>(inter);
+    }
+
+private:
+    explicit DBusProxyRegistry(QObject *parent = nullptr);
+
+private:
+    static QPointer<DBusProxyRegistry> INSTANCE;
+
+    QHash<QString, QDBusAbstractInterface *> m_proxies;     // 接口名称 -> 代理对象
+};
+
+#endif // DBUSPROXYREGISTRY_H
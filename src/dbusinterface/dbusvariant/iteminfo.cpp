@@ -142,6 +142,7 @@ ItemInfo_v1::ItemInfo_v1(const ItemInfo_v1 &info)
     , m_name(info.m_name)
     , m_key(info.m_key)
     , m_iconKey(info.m_iconKey)
+    , m_keywords(info.m_keywords)
     , m_status(info.m_status)
     , m_categoryId(info.m_categoryId)
     , m_description(info.m_description)
@@ -7,6 +7,7 @@
 #include "calculate_util.h"
 #include "util.h"
 #include "appslistmodel.h"
+#include "appgridview.h"
 
 #include <QDebug>
 #include <QPixmap>
@@ -26,7 +27,15 @@ AppItemDelegate::AppItemDelegate(QObject *parent)
     , m_calcUtil(CalculateUtil::instance())
     , m_blueDotPixmap(QIcon(":/skin/images/new_install_indicator.svg").pixmap(QSize(10, 10)))
     , m_autoStartPixmap(QIcon(":/skin/images/emblem-autostart.svg").pixmap(QSize(24, 24)))
+    , m_layoutCache(DLauncher::ITEM_LAYOUT_CACHE_COUNT)
 {
+    // 图标、item 大小或字体变化后缓存的布局失效
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppItemDelegate::clearLayoutCache);
+}
+
+void AppItemDelegate::clearLayoutCache()
+{
+    m_layoutCache.clear();
 }
 
 void AppItemDelegate::setCurrentIndex(const QModelIndex &index)
@@ -54,7 +63,9 @@ void AppItemDelegate::setItemList(const ItemInfoList_v1 &items)
 
 void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    if (index.data(AppsListModel::AppItemIsDraggingRole).value<bool>() && !(option.features & QStyleOptionViewItem::HasDisplay))
+    // 一次获取绘制所需的全部数据, 避免逐个角色调用 data()
+    const AppsListModel::RowSnapshot snapshot = index.data(AppsListModel::AppRowSnapshotRole).value<AppsListModel::RowSnapshot>();
+    if (snapshot.isDragging && !(option.features & QStyleOptionViewItem::HasDisplay))
         return;
 
 #ifdef QT_DEBUG
@@ -66,19 +77,16 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     painter->setPen(Qt::white);
     painter->setBrush(QBrush(Qt::transparent));
 
-    const ItemInfo_v1 itemInfo = index.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
-    const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
-    const bool itemIsDir = index.data(AppsListModel::ItemIsDirRole).toBool();
-    const ItemInfoList_v1 itemList = index.data(AppsListModel::DirItemInfoRole).value<ItemInfoList_v1>();
-    const int itemStatus = index.data(AppsListModel::AppItemStatusRole).toInt();
-
-    QList<QPixmap> pixmapList;
+    const QPixmap &iconPix = snapshot.icon;
+    const bool itemIsDir = snapshot.isDir;
+    const int itemStatus = snapshot.status;
 
-    const int fontPixelSize = index.data(AppsListModel::AppFontSizeRole).value<int>();
-    const bool drawBlueDot = index.data(AppsListModel::AppNewInstallRole).toBool();
-    const bool is_current = CurrentIndex == index;
-    const QRect itemBoundRect = itemBoundingRect(option.rect);
-    const QSize iconSize = index.data(AppsListModel::AppIconSizeRole).toSize();
+    const int fontPixelSize = snapshot.fontPixelSize;
+    const bool drawBlueDot = snapshot.isNewInstall;
+    // 生成翻页用的页面缓存时不绘制悬停、选中样式
+    const AppGridView *view = qobject_cast<const AppGridView *>(option.widget);
+    const bool is_current = CurrentIndex == index && !(view && view->isRenderingPageCache());
+    const QSize iconSize = snapshot.iconSize;
 
     QFont appNamefont(painter->font());
     if (fontPixelSize <= 0)
@@ -87,55 +95,14 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     appNamefont.setPixelSize(fontPixelSize);
     const QFontMetrics fm(appNamefont);
     painter->setOpacity(1);
-    const static double x1 = 0.26418192;
-    const static double x2 = -0.38890932;
-    const double result = x1 * itemBoundRect.width() + x2 * iconSize.width();
-    int margin = result > 0 ? result * 0.71 : 1;
-
-    // adjust
-    QRect br;
-    QRect iconRect;
-    QRectF appNameRect;
-    QString appNameResolved;
-    bool adjust = false;
-    bool  TextSecond = 0;
-    do {
-        // adjust
-        if (adjust)
-            --margin;
-        br = itemBoundRect.marginsRemoved(QMargins(margin, 1, margin, margin * 2));
-
-        // calc icon rect
-        const int iconLeftMargins = (br.width() - iconSize.width()) / 2;
-        int iconTopMargin = ICONTOTOP;
-        iconRect = QRect(br.topLeft() + QPoint(iconLeftMargins, iconTopMargin - 2), iconSize);
 
-        //31是字体设置20的时候的高度
-        br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
-        if (br.height() > itemBoundRect.height())
-            br.setHeight(itemBoundRect.height() - 1);
-
-        // calc text
-        appNameRect = itemTextRect(br, iconRect, drawBlueDot);
-
-        bool showSuffix = ConfigWorker::getValue(DLauncher::SHOW_LINGLONG_SUFFIX).toBool();
-        bool isLingLongApp = itemInfo.isLingLongApp();
-        bool isDir = itemInfo.m_isDir;
-        const QString &displayName = (showSuffix && isLingLongApp && !isDir) ? (QString("%1(%2)").arg(itemInfo.m_name).arg(tr("LingLong"))) : itemInfo.m_name;
-        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, displayName, appNameRect.toRect());
-        appNameResolved = appTextResolvedInfo.first;
-
-        if ((fm.width(appNameResolved) + (drawBlueDot ? (m_blueDotPixmap.width() + 10) : 0)) >= appNameRect.width())
-            TextSecond = 1;
-
-        if (margin == 1 || appTextResolvedInfo.second) {
-            br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
-            appNameRect = itemTextRect(br, iconRect, drawBlueDot);
-            break;
-        }
-
-        adjust = true;
-    } while (true);
+    // 布局只与名称、字体及 item 大小有关, 悬停、选中等重绘直接使用缓存的结果
+    const ItemLayout layout = itemLayout(appNamefont, option.rect.size(), snapshot);
+    QRect br = layout.br.translated(option.rect.topLeft());
+    const QRect iconRect = layout.iconRect.translated(option.rect.topLeft());
+    QRectF appNameRect = layout.appNameRect.translated(option.rect.topLeft());
+    const QString &appNameResolved = layout.appNameResolved;
+    const bool TextSecond = layout.textSecond;
 
     // 绘制选中样式
    if (is_current && !(option.features & QStyleOptionViewItem::HasDisplay) && !itemIsDir && m_calcUtil->fullscreen()) {
@@ -180,7 +147,7 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     }
 
     if (m_calcUtil->fullscreen())
-        drawAppDrawer(painter, index, iconRect);
+        drawAppDrawer(painter, index, snapshot, iconRect);
 
     painter->setFont(appNamefont);
     painter->setBrush(QBrush(Qt::transparent));
@@ -209,10 +176,10 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         if (!itemIsDir && itemStatus == ItemInfo_v1::Busy) {
             painter->drawText(appNameRect, appNameResolved, appNameOption);
             QStyleOptionProgressBar progressBar;
-            progressBar.text = QString::number(itemInfo.m_progressValue);
+            progressBar.text = QString::number(snapshot.progressValue);
             progressBar.minimum = 0;
             progressBar.maximum = 100;
-            progressBar.progress = itemInfo.m_progressValue;
+            progressBar.progress = snapshot.progressValue;
             progressBar.invertedAppearance = true;
             progressBar.orientation = Qt::Horizontal;
             progressBar.textVisible = true;
@@ -221,18 +188,17 @@ void AppItemDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
 
             QStyleOptionButton button;
             button.rect = buttonRect.toRect();
-            button.text = itemInfo.m_description;
+            button.text = snapshot.description;
             QApplication::style()->drawControl(QStyle::CE_ProgressBar, &progressBar, painter);
             QApplication::style()->drawControl(QStyle::CE_PushButton, &button, painter);
         } else {
-            const ItemInfo_v1 info = index.data(AppsListModel::DirNameRole).value<ItemInfo_v1>();
             painter->drawText(appNameRect, appNameResolved, appNameOption);
         }
     }
 
     if (!itemIsDir) {
         painter->drawPixmap(iconRect, iconPix, iconPix.rect());
-        if (index.data(AppsListModel::AppAutoStartRole).toBool()) {
+        if (snapshot.isAutoStart) {
             const QPoint autoStartIconPos = iconRect.bottomLeft()
                     - QPoint(m_autoStartPixmap.height(), m_autoStartPixmap.width()) / m_autoStartPixmap.devicePixelRatioF() / 2
                     + QPoint(iconRect.width() / 10, -iconRect.height() / 10);
@@ -257,6 +223,84 @@ QSize AppItemDelegate::sizeHint(const QStyleOptionViewItem &option, const QModel
     return index.data(AppsListModel::ItemSizeHintRole).toSize();
 }
 
+/**
+ * @brief AppItemDelegate::itemLayout 计算 item 中图标、名称的位置及名称的省略或换行结果
+ * 逐像素缩小边距直到名称可以完整显示, 计算量较大, 结果按名称、字体、item 大小等缓存, 布局变化时清空
+ * @param font 应用名称的字体
+ * @param itemSize item 的大小
+ * @param snapshot 应用的绘制数据
+ * @return 相对于 item 左上角的布局
+ */
+const AppItemDelegate::ItemLayout AppItemDelegate::itemLayout(const QFont &font, const QSize &itemSize, const AppsListModel::RowSnapshot &snapshot) const
+{
+    const QSize &iconSize = snapshot.iconSize;
+    const bool drawBlueDot = snapshot.isNewInstall;
+    const int fontPixelSize = snapshot.fontPixelSize;
+    const QString cacheKey = QString("%1|%2|%3x%4|%5x%6|%7").arg(font.key()).arg(drawBlueDot)
+            .arg(itemSize.width()).arg(itemSize.height()).arg(iconSize.width()).arg(iconSize.height()).arg(snapshot.displayName);
+
+    if (const ItemLayout *cachedLayout = m_layoutCache.object(cacheKey))
+        return *cachedLayout;
+
+    const QFontMetrics fm(font);
+    const QRect itemBoundRect = itemBoundingRect(QRect(QPoint(0, 0), itemSize));
+    const static double x1 = 0.26418192;
+    const static double x2 = -0.38890932;
+    const double result = x1 * itemBoundRect.width() + x2 * iconSize.width();
+    int margin = result > 0 ? result * 0.71 : 1;
+
+    // adjust
+    QRect br;
+    QRect iconRect;
+    QRectF appNameRect;
+    QString appNameResolved;
+    bool adjust = false;
+    bool  TextSecond = 0;
+    do {
+        // adjust
+        if (adjust)
+            --margin;
+        br = itemBoundRect.marginsRemoved(QMargins(margin, 1, margin, margin * 2));
+
+        // calc icon rect
+        const int iconLeftMargins = (br.width() - iconSize.width()) / 2;
+        int iconTopMargin = ICONTOTOP;
+        iconRect = QRect(br.topLeft() + QPoint(iconLeftMargins, iconTopMargin - 2), iconSize);
+
+        //31是字体设置20的时候的高度
+        br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
+        if (br.height() > itemBoundRect.height())
+            br.setHeight(itemBoundRect.height() - 1);
+
+        // calc text
+        appNameRect = itemTextRect(br, iconRect, drawBlueDot);
+
+        const QPair<QString, bool> appTextResolvedInfo = holdTextInRect(fm, snapshot.displayName, appNameRect.toRect());
+        appNameResolved = appTextResolvedInfo.first;
+
+        if ((fm.width(appNameResolved) + (drawBlueDot ? (m_blueDotPixmap.width() + 10) : 0)) >= appNameRect.width())
+            TextSecond = 1;
+
+        if (margin == 1 || appTextResolvedInfo.second) {
+            br.setHeight(ICONTOTOP + iconRect.height() + TEXTTOICON + 31 + fontPixelSize * TextSecond + TEXTTOLEFT);
+            appNameRect = itemTextRect(br, iconRect, drawBlueDot);
+            break;
+        }
+
+        adjust = true;
+    } while (true);
+
+    ItemLayout layout;
+    layout.br = br;
+    layout.iconRect = iconRect;
+    layout.appNameRect = appNameRect;
+    layout.appNameResolved = appNameResolved;
+    layout.textSecond = TextSecond;
+    m_layoutCache.insert(cacheKey, new ItemLayout(layout));
+
+    return layout;
+}
+
 const QRect AppItemDelegate::itemBoundingRect(const QRect &itemRect) const
 {
     const int w = itemRect.width();
@@ -296,24 +340,23 @@ const QPair<QString, bool> AppItemDelegate::holdTextInRect(const QFontMetrics &f
  * @brief AppItemDelegate::drawAppDrawer
  * @param painter 绘画师
  * @param index 应用模型索引
+ * @param snapshot 应用的绘制数据
  * @param boundingRect 应用的边界矩形
  */
-void AppItemDelegate::drawAppDrawer(QPainter *painter, const QModelIndex &index, QRect iconRect) const
+void AppItemDelegate::drawAppDrawer(QPainter *painter, const QModelIndex &index, const AppsListModel::RowSnapshot &snapshot, QRect iconRect) const
 {
-    const bool itemIsDir = index.data(AppsListModel::ItemIsDirRole).toBool();
-    const ItemInfoList_v1 itemList = index.data(AppsListModel::DirItemInfoRole).value<ItemInfoList_v1>();
-    const QPixmap iconPix = index.data(AppsListModel::AppIconRole).value<QPixmap>();
+    const QPixmap &iconPix = snapshot.icon;
 
     // 读数据配置应用文件夹效果
     QRect AppdrawerRect = QRect(iconRect.topLeft(), iconRect.size());
-    if (itemIsDir && !itemList.isEmpty()) {
+    if (snapshot.isDir && snapshot.dirItemCount > 0) {
         QList<QPixmap> pixmapList = index.data(AppsListModel::DirAppIconsRole).value<QList<QPixmap>>();
         painter->setPen(Qt::transparent);
         painter->setBrush(QColor(93, 92, 90, 100));
         painter->drawRoundedRect(AppdrawerRect, RECT_REDIUS, RECT_REDIUS);
         // 绘制文件夹内其他应用
         // designer: show max to 4 icons
-        const int iconCount = qMin(4, itemList.size());
+        const int iconCount = qMin(4, snapshot.dirItemCount);
         for (int i = 0; i < iconCount; i++) {
             QPixmap itemPix = iconPix;
             if (i < pixmapList.size())
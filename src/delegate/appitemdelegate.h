@@ -5,10 +5,12 @@
 #ifndef APPITEMDELEGATE_H
 #define APPITEMDELEGATE_H
 #include "iteminfo.h"
+#include "appslistmodel.h"
 
 #include <DGuiApplicationHelper>
 
 #include <QAbstractItemDelegate>
+#include <QCache>
 #include <QModelIndex>
 #include <QStyleOptionViewItem>
 #include <QPainter>
@@ -28,16 +30,29 @@ public:
     void setDirModelIndex(QModelIndex dragIndex, QModelIndex dropIndex);
     void setItemList(const ItemInfoList_v1 &items);
     QRect appSourceRect(QRect rect, int index) const;
-    void drawAppDrawer(QPainter *painter, const QModelIndex &index, QRect iconRect) const;
+    void drawAppDrawer(QPainter *painter, const QModelIndex &index, const AppsListModel::RowSnapshot &snapshot, QRect iconRect) const;
 
 signals:
     void requestUpdate(const QModelIndex &idx) const;
 
+public slots:
+    void clearLayoutCache();
+
 protected:
     void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
     QSize sizeHint(const QStyleOptionViewItem &option, const QModelIndex &index) const;
 
 private:
+    struct ItemLayout
+    {
+        QRect br;                       // 选中样式的区域
+        QRect iconRect;
+        QRectF appNameRect;
+        QString appNameResolved;        // 省略或换行处理后的应用名称
+        bool textSecond;                // 名称是否显示为两行
+    };
+
+    const ItemLayout itemLayout(const QFont &font, const QSize &itemSize, const AppsListModel::RowSnapshot &snapshot) const;
     const QRect itemBoundingRect(const QRect &itemRect) const;
     const QRect itemTextRect(const QRect &boundingRect, const QRect &iconRect, const bool extraWidthMargin) const;
     const QPair<QString, bool> holdTextInRect(const QFontMetrics &fm, const QString &text, const QRect &rect) const;
@@ -51,6 +66,8 @@ private:
     QModelIndex m_dragIndex;
     QModelIndex m_dropIndex;
     ItemInfoList_v1 m_itemList;
+
+    mutable QCache<QString, ItemLayout> m_layoutCache;  // 名称、字体、item 大小 -> 布局
 };
 
 #endif // APPITEMDELEGATE_H
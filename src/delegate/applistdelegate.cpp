@@ -34,10 +34,10 @@ AppListDelegate::AppListDelegate(QObject *parent)
 
 void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
 {
-    if (index.data(AppsListModel::AppItemIsDraggingRole).value<bool>() &&
-            !(option.features & QStyleOptionViewItem::HasDisplay)) {
+    // 一次获取绘制所需的全部数据, 避免逐个角色调用 data()
+    const AppsListModel::RowSnapshot snapshot = index.data(AppsListModel::AppRowSnapshotRole).value<AppsListModel::RowSnapshot>();
+    if (snapshot.isDragging && !(option.features & QStyleOptionViewItem::HasDisplay))
         return;
-    }
 
     if (!m_actived)
         return;
@@ -45,8 +45,8 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     const qreal ratio = qApp->devicePixelRatio();
     const QRect rect = option.rect;
     const bool isAlternate = option.features & QStyleOptionViewItem::Alternate;
-    const QPixmap iconPixmap = index.data(AppsListModel::AppListIconRole).value<QPixmap>();
-    const bool isTitle = index.data(AppsListModel::AppItemTitleRole).toBool();
+    const QPixmap &iconPixmap = snapshot.icon;
+    const bool isTitle = snapshot.isTitle;
 
     painter->setPen(Qt::NoPen);
 
@@ -71,7 +71,7 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         painter->setBrush(Qt::NoBrush);
     }
 
-    if (index.data(AppsListModel::DrawBackgroundRole).toBool())
+    if (snapshot.drawBackground)
         painter->drawRoundedRect(option.rect.marginsRemoved(QMargins(15, 0, 0, 0)), 8, 8);
 
     const int iconX = rect.x() + 20;
@@ -81,7 +81,7 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
         painter->drawPixmap(iconX, iconY, iconPixmap);
 
     // draw icon if app is auto startup
-    if (index.data(AppsListModel::AppAutoStartRole).toBool()) {
+    if (snapshot.isAutoStart) {
         painter->drawPixmap(iconX, iconY + 16, m_autoStartPixmap);
     }
 
@@ -92,7 +92,7 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     textRect.setWidth(qRound(textRect.width() - m_blueDotPixmap.width() / ratio));
     painter->setPen(QPen(QPalette().brightText(), 1));
 
-    const QString &appName = painter->fontMetrics().elidedText(index.data(AppsListModel::AppNameRole).toString(), Qt::ElideRight, textRect.width());
+    const QString &appName = painter->fontMetrics().elidedText(snapshot.displayName, Qt::ElideRight, textRect.width());
 
     if (isTitle) {
         painter->setOpacity(0.5);
@@ -112,7 +112,7 @@ void AppListDelegate::paint(QPainter *painter, const QStyleOptionViewItem &optio
     painter->setOpacity(1);
 
     // draw blue dot if needed
-    if (index.data(AppsListModel::AppNewInstallRole).toBool() && !isAlternate && !isTitle) {
+    if (snapshot.isNewInstall && !isAlternate && !isTitle) {
         const QPointF blueDotPos(rect.width() - m_blueDotPixmap.width() / ratio - 6,
                                  rect.y() + (+ rect.height() - m_blueDotPixmap.height() / ratio) / 2);
 
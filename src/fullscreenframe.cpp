@@ -418,8 +418,6 @@ void FullScreenFrame::initAppView()
     m_multiPagesView->installEventFilter(this);
 
     m_filterModel->setSourceModel(m_allAppsModel);
-    m_filterModel->setFilterRole(AppsListModel::AppRawItemInfoRole);
-    m_filterModel->setFilterKeyColumn(0);
     m_filterModel->setSortCaseSensitivity(Qt::CaseInsensitive);
 }
 
@@ -445,6 +443,14 @@ void FullScreenFrame::initConnection()
     connect(m_appsManager, &AppsManager::requestHideTips, this, &FullScreenFrame::hideTips);
     connect(m_appsManager, &AppsManager::IconSizeChanged, this, &FullScreenFrame::updateDockPosition);
     connect(m_appsManager, &AppsManager::dataChanged, this, &FullScreenFrame::refreshPageView);
+
+    // 逐行更新时只有全屏列表的变化会影响页数
+    auto refreshPageCount = [ this ](const AppsListModel::AppCategory category) {
+        if (category == AppsListModel::FullscreenAll)
+            refreshPageView(category);
+    };
+    connect(m_appsManager, &AppsManager::itemInserted, this, refreshPageCount);
+    connect(m_appsManager, &AppsManager::itemRemoved, this, refreshPageCount);
     connect(m_appsManager, &AppsManager::requestHidePopup, this, &FullScreenFrame::onRequestHidePopUp);
 
     connect(m_curScreen, &QScreen::geometryChanged, this, &FullScreenFrame::onScreenInfoChange);
@@ -652,7 +658,11 @@ void FullScreenFrame::refreshPageView(AppsListModel::AppCategory category)
     if (!isVisible())
         return;
 
-    if (AppsListModel::Search == category) {
+    // 小窗口的列表与全屏的页面无关
+    if (AppsListModel::WindowedAll == category || AppsListModel::TitleMode == category || AppsListModel::LetterMode == category)
+        return;
+
+    if (AppsListModel::Search == category || AppsListModel::PluginSearch == category) {
         m_searchModeWidget->setSearchModel(m_filterModel);
     } else {
         m_multiPagesView->updatePageCount(category);
@@ -945,8 +955,7 @@ void FullScreenFrame::searchTextChanged(const QString &keywords, bool enableUpda
         keyWord = keyWord.remove(QRegExp("\\s"));
 
         emit searchApp(keyWord);
-        QRegExp regExp(keyWord, Qt::CaseInsensitive);
-        m_filterModel->setFilterRegExp(regExp);
+        m_filterModel->setSearchText(keyWord);
         m_searchModeWidget->setSearchModel(m_filterModel);
         m_searchModeWidget->selectFirstItem();
     }
@@ -6,8 +6,8 @@
 #include "util.h"
 #include "constants.h"
 #include "appslistmodel.h"
-#include "amdbuslauncherinterface.h"
 #include "amdbusdockinterface.h"
+#include "dbusproxyregistry.h"
 
 #include <QDebug>
 #include <QDesktopWidget>
@@ -194,9 +194,8 @@ void CalculateUtil::calculateAppLayout(const QSize &containerSize, const int cur
  */
 CalculateUtil::CalculateUtil(QObject *parent)
     : QObject(parent)
-    , m_amDbusLauncher(new AMDBusLauncherInter(this))
-    , m_amDbusDockInter(new AMDBusDockInter(this))
-    , m_isFullScreen(m_amDbusLauncher->fullscreen())
+    , m_amDbusDockInter(DBusProxyRegistry::instance()->proxy<AMDBusDockInter>())
+    , m_isFullScreen(false)     // 由 LauncherSys 启动时读取全屏属性后设置, 之后由 FullscreenChanged 信号更新
     , m_launcherGsettings(SettingsPtr("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", this))
     , m_appItemFontSize(12)
     , m_appItemSpacing(10)
@@ -16,7 +16,6 @@
 
 DCORE_USE_NAMESPACE
 
-class AMDBusLauncherInter;
 class AMDBusDockInter;
 
 class CalculateUtil : public QObject
@@ -75,7 +74,6 @@ private:
 
 private:
     static QPointer<CalculateUtil> INSTANCE;
-    AMDBusLauncherInter *m_amDbusLauncher;
     AMDBusDockInter *m_amDbusDockInter;
 
     bool m_isFullScreen;
@@ -74,6 +74,14 @@ static const int DOCK_POS_BOTTOM = 2;
 static const int DOCK_POS_LEFT = 3;                                                 // 任务栏位置: 左边
 
 static const int CHANGE_PAGE_DELAY_TIME = 250;                                      // 翻页延时时间，防抖动
+static const int ICON_CACHE_COST_LIMIT = 48 * 1024 * 1024;                          // 应用图标缓存上限(字节)
+static const int SEARCH_RESULT_MAX_COUNT = 100;                                     // 搜索结果最多显示的应用个数
+static const int PLUGIN_SEARCH_DELAY_TIME = 150;                                    // 插件搜索防抖延时(毫秒)
+static const int PLUGIN_SEARCH_TIMEOUT = 3000;                                      // 单个插件搜索超时时间(毫秒), 超时的结果丢弃
+static const int ITEM_LAYOUT_CACHE_COUNT = 1024;                                    // 应用 item 布局缓存的最大个数
+static const int AUTOSTART_SAVE_DELAY_TIME = 1000;                                  // 自启动应用列表延迟写入配置文件的时间(毫秒), 合并连续的修改
+static const int LIST_SAVE_DELAY_TIME = 500;                                        // 应用排序列表延迟写入缓存文件的时间(毫秒), 合并连续的修改
+static const int GROUP_LIST_REFRESH_DELAY_TIME = 300;                               // 应用安装、卸载后延迟重新生成标题及字母模式列表的时间(毫秒), 合并连续的变化
 static const QString SOLID_BACKGROUND_COLOR = "#000F27";                            // 纯色背景色号
 static const QString DEFAULT_META_CONFIG_NAME = "org.deepin.dde.launcher";          // 默认的配置文件名称
 static const QString UNABLE_TO_DOCK_LIST = "unable-to-dock-list";                   // 拖拽到任务栏驻留配置功能
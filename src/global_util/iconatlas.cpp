@@ -0,0 +1,380 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconatlas.h"
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QIcon>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <cstring>
+
+DGUI_USE_NAMESPACE
+
+namespace {
+
+/**
+ * 图集文件布局:
+ * | AtlasHeader | 像素数据(每个图标按 16 字节对齐) | 索引(QDataStream) |
+ */
+struct AtlasHeader
+{
+    quint32 magic;
+    quint32 version;
+    quint64 indexOffset;
+    quint64 indexSize;
+};
+
+}
+
+static const quint32 ATLAS_MAGIC = 0x41494c44;      // "DLIA"
+static const quint32 ATLAS_VERSION = 1;
+static const int ATLAS_ALIGNMENT = 16;
+
+QPointer<IconAtlas> IconAtlas::INSTANCE = nullptr;
+
+IconAtlas *IconAtlas::instance()
+{
+    if (INSTANCE.isNull()) {
+        INSTANCE = new IconAtlas;
+        INSTANCE->load(defaultFilePath());
+    }
+
+    return INSTANCE;
+}
+
+IconAtlas::IconAtlas(QObject *parent)
+    : QObject(parent)
+    , m_mappedData(nullptr)
+    , m_dirty(false)
+{
+    // 图标主题变化后图集中的图标全部失效, 退出时写入的是新主题下的图标
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, &IconAtlas::clear);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &IconAtlas::save);
+}
+
+IconAtlas::~IconAtlas()
+{
+    unmap();
+}
+
+/**
+ * @brief IconAtlas::defaultFilePath 图集文件的默认路径
+ * @return ~/.cache/dde-launcher/icon-atlas.cache
+ */
+QString IconAtlas::defaultFilePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + "/dde-launcher/icon-atlas.cache";
+}
+
+/**
+ * @brief IconAtlas::iconThemeModifiedTime 获取图标主题目录的最新修改时间, 用于判断图集是否过期
+ * @param themeName 图标主题名称
+ * @param searchPaths 图标主题搜索路径
+ * @return 主题目录及 index.theme 中最新的修改时间(毫秒)
+ */
+qint64 IconAtlas::iconThemeModifiedTime(const QString &themeName, const QStringList &searchPaths)
+{
+    qint64 modifiedTime = 0;
+
+    for (const QString &name : { themeName, QString("hicolor") }) {
+        if (name.isEmpty())
+            continue;
+
+        for (const QString &searchPath : searchPaths) {
+            const QString themeDir = searchPath + "/" + name;
+            for (const QString &path : { themeDir, themeDir + "/index.theme" }) {
+                const QFileInfo info(path);
+                if (info.exists())
+                    modifiedTime = qMax(modifiedTime, info.lastModified().toMSecsSinceEpoch());
+            }
+        }
+    }
+
+    return modifiedTime;
+}
+
+static qint64 desktopModifiedTime(const QString &desktop)
+{
+    const QFileInfo info(desktop);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : 0;
+}
+
+/**
+ * @brief IconAtlas::load 映射并解析图集文件, 主题已变化或文件损坏时丢弃整个图集
+ * @param filePath 图集文件路径
+ * @return 是否加载成功
+ */
+bool IconAtlas::load(const QString &filePath)
+{
+    unmap();
+    m_entries.clear();
+    m_newImages.clear();
+    m_dirty = false;
+    m_filePath = filePath;
+
+    m_file.setFileName(filePath);
+    if (!m_file.exists() || !m_file.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < qint64(sizeof(AtlasHeader)))
+        return false;
+
+    m_mappedData = m_file.map(0, fileSize);
+    if (!m_mappedData) {
+        qWarning() << "failed to map icon atlas:" << filePath << m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    AtlasHeader header;
+    memcpy(&header, m_mappedData, sizeof(AtlasHeader));
+    if (header.magic != ATLAS_MAGIC || header.version != ATLAS_VERSION
+            || header.indexOffset < sizeof(AtlasHeader) || header.indexOffset + header.indexSize > quint64(fileSize)) {
+        qWarning() << "icon atlas is invalid, discard it:" << filePath;
+        unmap();
+        m_dirty = true;
+        return false;
+    }
+
+    const QByteArray index = QByteArray::fromRawData(reinterpret_cast<const char *>(m_mappedData + header.indexOffset), int(header.indexSize));
+    QDataStream stream(index);
+
+    QString themeName;
+    qint64 themeModifiedTime = 0;
+    quint32 count = 0;
+    stream >> themeName >> themeModifiedTime >> count;
+
+    if (themeName != QIcon::themeName() || themeModifiedTime != iconThemeModifiedTime(themeName, QIcon::themeSearchPaths())) {
+        qDebug() << "icon theme changed, discard icon atlas";
+        unmap();
+        m_dirty = true;
+        return false;
+    }
+
+    for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString key;
+        Entry entry;
+        stream >> key >> entry.desktop >> entry.desktopModifiedTime >> entry.devicePixelRatio
+               >> entry.width >> entry.height >> entry.bytesPerLine >> entry.offset;
+        entry.checked = false;
+
+        const quint64 dataSize = quint64(entry.bytesPerLine) * quint64(entry.height);
+        if (stream.status() != QDataStream::Ok || entry.width <= 0 || entry.height <= 0
+                || entry.bytesPerLine < entry.width * 4 || entry.offset < sizeof(AtlasHeader)
+                || entry.offset + dataSize > header.indexOffset)
+            break;
+
+        m_entries.insert(key, entry);
+    }
+
+    if (stream.status() != QDataStream::Ok || quint32(m_entries.size()) != count) {
+        qWarning() << "icon atlas index is corrupted, discard it:" << filePath;
+        m_entries.clear();
+        unmap();
+        m_dirty = true;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief IconAtlas::find 从图集中查找图标, 首次访问时校验 desktop 文件是否在写入图集后被修改
+ * @param key 缓存键, 由 cacheKey() 生成
+ * @param desktop 应用的desktop全路径
+ * @param pixmap 查找到的图标
+ * @return 是否命中
+ */
+bool IconAtlas::find(const QString &key, const QString &desktop, QPixmap &pixmap)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return false;
+
+    Entry &entry = it.value();
+    if (!entry.checked) {
+        if (entry.desktop != desktop || entry.desktopModifiedTime != desktopModifiedTime(desktop)) {
+            m_entries.erase(it);
+            m_dirty = true;
+            return false;
+        }
+
+        entry.checked = true;
+    }
+
+    QImage image;
+    if (entry.offset == 0) {
+        image = m_newImages.value(key);
+    } else if (m_mappedData) {
+        // 直接引用映射区域中的像素数据, 不需要解码
+        image = QImage(m_mappedData + entry.offset, entry.width, entry.height, entry.bytesPerLine, QImage::Format_ARGB32_Premultiplied);
+    }
+
+    if (image.isNull())
+        return false;
+
+    // 格式相同时 QPixmap 会直接引用图片的数据, 而 save() 后旧的映射会被释放, 因此先拷贝一次
+    pixmap = QPixmap::fromImage(entry.offset == 0 ? image : image.copy());
+    pixmap.setDevicePixelRatio(entry.devicePixelRatio);
+    return !pixmap.isNull();
+}
+
+/**
+ * @brief IconAtlas::insert 记录本次运行中渲染的图标, 在 save() 时写入图集文件
+ * @param key 缓存键, 由 cacheKey() 生成
+ * @param desktop 应用的desktop全路径
+ * @param image 图标图片
+ * @param ratio 缩放比
+ */
+void IconAtlas::insert(const QString &key, const QString &desktop, const QImage &image, const qreal ratio)
+{
+    // 日历图标每天变化, 不写入图集
+    if (key.isEmpty() || desktop.isEmpty() || image.isNull() || desktop.contains("/dde-calendar.desktop"))
+        return;
+
+    const QImage argbImage = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+
+    Entry entry;
+    entry.desktop = desktop;
+    entry.desktopModifiedTime = desktopModifiedTime(desktop);
+    entry.devicePixelRatio = ratio;
+    entry.width = argbImage.width();
+    entry.height = argbImage.height();
+    entry.bytesPerLine = argbImage.bytesPerLine();
+    entry.offset = 0;
+    entry.checked = true;
+
+    m_entries.insert(key, entry);
+    m_newImages.insert(key, argbImage);
+    m_dirty = true;
+}
+
+/**
+ * @brief IconAtlas::removeItem 移除应用所有尺寸下的图标
+ * @param desktop 应用的desktop全路径
+ */
+void IconAtlas::removeItem(const QString &desktop)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it.value().desktop == desktop) {
+            m_newImages.remove(it.key());
+            it = m_entries.erase(it);
+            m_dirty = true;
+        } else {
+            ++it;
+        }
+    }
+}
+
+int IconAtlas::count() const
+{
+    return m_entries.size();
+}
+
+/**
+ * @brief IconAtlas::save 将图集写入磁盘, 图集未变化时不写入
+ * 先写入临时文件再替换, 旧文件的映射在替换前一直有效
+ * @return 是否写入成功
+ */
+bool IconAtlas::save()
+{
+    if (!m_dirty || m_filePath.isEmpty())
+        return true;
+
+    QDir().mkpath(QFileInfo(m_filePath).absolutePath());
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning() << "failed to open icon atlas:" << m_filePath << file.errorString();
+        return false;
+    }
+
+    AtlasHeader header;
+    memset(&header, 0, sizeof(AtlasHeader));
+    file.write(reinterpret_cast<const char *>(&header), sizeof(AtlasHeader));
+
+    QByteArray index;
+    QDataStream stream(&index, QIODevice::WriteOnly);
+    const QString themeName = QIcon::themeName();
+    stream << themeName << iconThemeModifiedTime(themeName, QIcon::themeSearchPaths());
+
+    QList<QPair<QString, Entry>> entries;
+    for (auto it = m_entries.constBegin(); it != m_entries.constEnd(); ++it) {
+        Entry entry = it.value();
+        const uchar *data = nullptr;
+
+        if (entry.offset == 0) {
+            const QImage &image = m_newImages[it.key()];
+            data = image.constBits();
+        } else if (m_mappedData) {
+            data = m_mappedData + entry.offset;
+        }
+
+        if (!data)
+            continue;
+
+        const qint64 padding = (ATLAS_ALIGNMENT - file.pos() % ATLAS_ALIGNMENT) % ATLAS_ALIGNMENT;
+        file.write(QByteArray(int(padding), '\0'));
+
+        entry.offset = quint64(file.pos());
+        file.write(reinterpret_cast<const char *>(data), qint64(entry.bytesPerLine) * entry.height);
+        entries << qMakePair(it.key(), entry);
+    }
+
+    stream << quint32(entries.size());
+    for (const auto &pair : entries) {
+        const Entry &entry = pair.second;
+        stream << pair.first << entry.desktop << entry.desktopModifiedTime << entry.devicePixelRatio
+               << entry.width << entry.height << entry.bytesPerLine << entry.offset;
+    }
+
+    header.magic = ATLAS_MAGIC;
+    header.version = ATLAS_VERSION;
+    header.indexOffset = quint64(file.pos());
+    header.indexSize = quint64(index.size());
+    file.write(index);
+
+    file.seek(0);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(AtlasHeader));
+
+    if (!file.commit()) {
+        qWarning() << "failed to write icon atlas:" << m_filePath << file.errorString();
+        return false;
+    }
+
+    // 重新映射新文件, 释放本次运行新增图标占用的内存
+    return load(m_filePath);
+}
+
+/**
+ * @brief IconAtlas::clear 清空图集, 下次保存时覆盖磁盘上的文件
+ */
+void IconAtlas::clear()
+{
+    m_entries.clear();
+    m_newImages.clear();
+    m_dirty = true;
+}
+
+void IconAtlas::unmap()
+{
+    if (m_mappedData)
+        m_file.unmap(m_mappedData);
+
+    m_mappedData = nullptr;
+
+    if (m_file.isOpen())
+        m_file.close();
+}
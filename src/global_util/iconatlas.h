@@ -0,0 +1,73 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ICONATLAS_H
+#define ICONATLAS_H
+
+#include <QObject>
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPointer>
+
+/**应用图标的磁盘缓存
+ * 将光栅化后的图标按尺寸档位和缩放比写入 ~/.cache/dde-launcher/ 下的单个图集文件,
+ * 启动时通过内存映射读取, 冷启动首次显示时无需再查找主题和解码图标文件
+ * 图集以图标主题目录的修改时间整体校验, 每个图标以对应 desktop 文件的修改时间单独校验
+ * @brief The IconAtlas class
+ */
+class IconAtlas : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconAtlas *instance();
+    ~IconAtlas() override;
+
+    bool load(const QString &filePath);
+    bool find(const QString &key, const QString &desktop, QPixmap &pixmap);
+    void insert(const QString &key, const QString &desktop, const QImage &image, const qreal ratio);
+    void removeItem(const QString &desktop);
+
+    QString filePath() const { return m_filePath; }
+    int count() const;
+
+    static QString defaultFilePath();
+    static qint64 iconThemeModifiedTime(const QString &themeName, const QStringList &searchPaths);
+
+public slots:
+    bool save();
+    void clear();
+
+private:
+    explicit IconAtlas(QObject *parent = nullptr);
+
+    void unmap();
+
+private:
+    struct Entry
+    {
+        QString desktop;
+        qint64 desktopModifiedTime;
+        qreal devicePixelRatio;
+        qint32 width;
+        qint32 height;
+        qint32 bytesPerLine;
+        quint64 offset;                     // 映射区域中像素数据的偏移, 为 0 时表示本次运行新增的图标
+        bool checked;                       // 是否已校验过 desktop 文件的修改时间
+    };
+
+    static QPointer<IconAtlas> INSTANCE;
+
+    QString m_filePath;
+    QFile m_file;
+    uchar *m_mappedData;
+
+    QHash<QString, Entry> m_entries;        // 缓存键 -> 图标信息
+    QHash<QString, QImage> m_newImages;     // 本次运行新增的图标, 写入磁盘后释放
+    bool m_dirty;
+};
+
+#endif // ICONATLAS_H
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconcachemanager.h"
+#include "constants.h"
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+#include <QDebug>
+
+DGUI_USE_NAMESPACE
+
+QPointer<IconCacheManager> IconCacheManager::INSTANCE = nullptr;
+
+IconCacheManager *IconCacheManager::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new IconCacheManager;
+
+    return INSTANCE;
+}
+
+IconCacheManager::IconCacheManager(QObject *parent)
+    : QObject(parent)
+    , m_iconCache(DLauncher::ICON_CACHE_COST_LIMIT)
+    , m_hitCount(0)
+    , m_missCount(0)
+{
+    // 主题类型或图标主题变化时, 缓存的图标全部失效
+    connect(DGuiApplicationHelper::instance(), &DGuiApplicationHelper::themeTypeChanged, this, &IconCacheManager::clear);
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, &IconCacheManager::clear);
+}
+
+/**
+ * @brief IconCacheManager::find 从缓存中查找图标
+ * @param key 缓存键
+ * @param pixmap 查找到的图标
+ * @return 是否命中缓存
+ */
+bool IconCacheManager::find(const QString &key, QPixmap &pixmap)
+{
+    const QPixmap *cachedPixmap = m_iconCache.object(key);
+    if (!cachedPixmap) {
+        ++m_missCount;
+        return false;
+    }
+
+    ++m_hitCount;
+    pixmap = *cachedPixmap;
+    return true;
+}
+
+/**
+ * @brief IconCacheManager::insert 缓存图标, 以图标占用的字节数作为代价
+ * @param key 缓存键
+ * @param pixmap 图标
+ */
+void IconCacheManager::insert(const QString &key, const QPixmap &pixmap)
+{
+    if (key.isEmpty() || pixmap.isNull())
+        return;
+
+    const int cost = pixmap.width() * pixmap.height() * pixmap.depth() / 8;
+    m_iconCache.insert(key, new QPixmap(pixmap), cost);
+}
+
+/**
+ * @brief IconCacheManager::removeItem 移除应用所有尺寸下的缓存图标
+ * @param desktop 应用的desktop全路径
+ */
+void IconCacheManager::removeItem(const QString &desktop)
+{
+    if (desktop.isEmpty())
+        return;
+
+    const QString prefix = desktop + QLatin1Char('|');
+    for (const QString &key : m_iconCache.keys()) {
+        if (key.startsWith(prefix))
+            m_iconCache.remove(key);
+    }
+}
+
+void IconCacheManager::setCostLimit(const int bytes)
+{
+    m_iconCache.setMaxCost(bytes);
+}
+
+int IconCacheManager::costLimit() const
+{
+    return m_iconCache.maxCost();
+}
+
+int IconCacheManager::totalCost() const
+{
+    return m_iconCache.totalCost();
+}
+
+void IconCacheManager::clear()
+{
+    qDebug() << "clear icon cache, hit:" << m_hitCount << ", miss:" << m_missCount
+             << ", cost:" << m_iconCache.totalCost();
+
+    m_iconCache.clear();
+}
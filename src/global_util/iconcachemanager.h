@@ -0,0 +1,49 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ICONCACHEMANAGER_H
+#define ICONCACHEMANAGER_H
+
+#include <QObject>
+#include <QCache>
+#include <QPixmap>
+#include <QPointer>
+
+/**应用图标缓存, 以字节数作为淘汰代价的 LRU 缓存
+ * 缓存键由 cacheKey() 生成: desktop|iconKey|图标尺寸档位|缩放比|图标主题
+ * @brief The IconCacheManager class
+ */
+class IconCacheManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconCacheManager *instance();
+
+    bool find(const QString &key, QPixmap &pixmap);
+    void insert(const QString &key, const QPixmap &pixmap);
+    void removeItem(const QString &desktop);
+
+    void setCostLimit(const int bytes);
+    int costLimit() const;
+    int totalCost() const;
+
+    quint64 hitCount() const { return m_hitCount; }
+    quint64 missCount() const { return m_missCount; }
+
+public slots:
+    void clear();
+
+private:
+    explicit IconCacheManager(QObject *parent = nullptr);
+
+private:
+    static QPointer<IconCacheManager> INSTANCE;
+
+    QCache<QString, QPixmap> m_iconCache;
+    quint64 m_hitCount;                     // 命中次数
+    quint64 m_missCount;                    // 未命中次数
+};
+
+#endif // ICONCACHEMANAGER_H
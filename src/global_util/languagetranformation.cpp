@@ -56,7 +56,7 @@ QString LanguageTransformation::zhToJianPin(const QString &chinese)
     if(chinese.isEmpty())
         return chinese;
 
-    QString strChineseFirstPY = m_jianpingStrList.join("");
+    const QString &strChineseFirstPY = m_jianpinStr;
 
     QString jianPinStr;
     int index = 0;
@@ -80,6 +80,14 @@ QString LanguageTransformation::zhToJianPin(const QString &chinese)
     return jianPinStr;
 }
 
+bool LanguageTransformation::isLoaded() const
+{
+    return !m_pinyinStrList.isEmpty() && !m_jianpinStr.isEmpty();
+}
+
+/** 在后台线程读取拼音库, 读取完成后在主线程中替换并通知
+ * @brief LanguageTransformation::readConfigFile
+ */
 void LanguageTransformation::readConfigFile()
 {
     QtConcurrent::run([ this ](){
@@ -90,8 +98,7 @@ void LanguageTransformation::readConfigFile()
             return;
         }
 
-        QString pinyinStr = pinYinFile.readAll();
-        m_pinyinStrList = pinyinStr.split(" ");
+        const QStringList pinyinStrList = QString(pinYinFile.readAll()).split(" ");
         pinYinFile.close();
 
         // 加载简拼配置库
@@ -101,8 +108,12 @@ void LanguageTransformation::readConfigFile()
             return;
         }
 
-        QString jianpinStr = jianpinFile.readAll();
-        m_jianpingStrList.append(jianpinStr);
-//        qInfo() << "m_jianpingStrList: " << m_jianpingStrList;
+        const QString jianpinStr = jianpinFile.readAll();
+
+        QMetaObject::invokeMethod(this, [ = ] {
+            m_pinyinStrList = pinyinStrList;
+            m_jianpinStr = jianpinStr;
+            emit configLoaded();
+        }, Qt::QueuedConnection);
     });
 }
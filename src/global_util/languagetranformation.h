@@ -17,12 +17,16 @@ public:
     QString zhToPinYin(const QString &chinese);
     QString zhToJianPin(const QString &chinese);
     void readConfigFile();
+    bool isLoaded() const;
+
+signals:
+    void configLoaded();
 
 private:
     static LanguageTransformation *m_instance;
 
     QStringList m_pinyinStrList;
-    QStringList m_jianpingStrList;
+    QString m_jianpinStr;
 };
 
 #endif
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "latencyhistogram.h"
+
+#include <QStringList>
+#include <QtMath>
+
+LatencyHistogram::LatencyHistogram(const int bucketCount)
+    : m_buckets(qMax(2, bucketCount), 0)
+    , m_count(0)
+{
+}
+
+/**
+ * @brief LatencyHistogram::record 记录一次耗时
+ * @param usecs 耗时(微秒)
+ */
+void LatencyHistogram::record(const qint64 usecs)
+{
+    int bucket = 0;
+    while (bucket < m_buckets.size() - 1 && usecs >= bucketUpperBound(bucket) * 1000)
+        ++bucket;
+
+    ++m_buckets[bucket];
+    ++m_count;
+}
+
+void LatencyHistogram::reset()
+{
+    m_buckets.fill(0);
+    m_count = 0;
+}
+
+int LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+int LatencyHistogram::bucketCount() const
+{
+    return m_buckets.size();
+}
+
+int LatencyHistogram::bucketValue(const int bucket) const
+{
+    return m_buckets.value(bucket);
+}
+
+/**
+ * @brief LatencyHistogram::bucketUpperBound 区间的上限(毫秒, 不含)
+ * @param bucket 区间序号
+ * @return 上限, 最后一个区间返回 -1
+ */
+qint64 LatencyHistogram::bucketUpperBound(const int bucket) const
+{
+    if (bucket < 0 || bucket >= m_buckets.size() - 1)
+        return -1;
+
+    return qint64(1) << bucket;
+}
+
+/**
+ * @brief LatencyHistogram::percentile 估算分位数
+ * @param ratio 分位, 如 0.95
+ * @return 分位数所在区间的上限(毫秒), 落在最后一个区间时返回 -1, 没有记录时返回 0
+ */
+qint64 LatencyHistogram::percentile(const double ratio) const
+{
+    if (m_count == 0)
+        return 0;
+
+    const int target = qMax(1, qCeil(m_count * qBound(0.0, ratio, 1.0)));
+    int accumulated = 0;
+    for (int bucket = 0; bucket < m_buckets.size(); ++bucket) {
+        accumulated += m_buckets.at(bucket);
+        if (accumulated >= target)
+            return bucketUpperBound(bucket);
+    }
+
+    return -1;
+}
+
+/**
+ * @brief LatencyHistogram::toString 输出各区间的次数, 例如 "<1ms:3 <2ms:1 >=256ms:0"
+ */
+QString LatencyHistogram::toString() const
+{
+    QStringList parts;
+    for (int bucket = 0; bucket < m_buckets.size(); ++bucket) {
+        const qint64 upperBound = bucketUpperBound(bucket);
+        const QString range = upperBound == -1 ? QString(">=%1ms").arg(bucketUpperBound(bucket - 1)) : QString("<%1ms").arg(upperBound);
+        parts << QString("%1:%2").arg(range).arg(m_buckets.at(bucket));
+    }
+
+    return parts.join(' ');
+}
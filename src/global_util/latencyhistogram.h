@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <QString>
+#include <QVector>
+
+/**耗时分布直方图
+ * 按 2 的幂次划分毫秒区间: [0, 1), [1, 2), [2, 4) ... 最后一个区间不设上限
+ * @brief The LatencyHistogram class
+ */
+class LatencyHistogram
+{
+public:
+    explicit LatencyHistogram(const int bucketCount = 10);
+
+    void record(const qint64 usecs);
+    void reset();
+
+    int count() const;
+    int bucketCount() const;
+    int bucketValue(const int bucket) const;
+    qint64 bucketUpperBound(const int bucket) const;
+    qint64 percentile(const double ratio) const;
+    QString toString() const;
+
+private:
+    QVector<int> m_buckets;
+    int m_count;
+};
+
+#endif // LATENCYHISTOGRAM_H
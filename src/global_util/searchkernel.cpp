@@ -0,0 +1,161 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchkernel.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define SEARCH_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief matchRest 首尾字符相同的候选位置, 校验中间的字符
+ */
+static inline bool matchRest(const ushort *haystack, const ushort *needle, const int needleSize)
+{
+    return needleSize <= 2 || memcmp(haystack + 1, needle + 1, size_t(needleSize - 2) * sizeof(ushort)) == 0;
+}
+
+static int indexOfScalar(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, int from)
+{
+    const int last = haystackSize - needleSize;
+    const ushort first = needle[0];
+    const ushort tail = needle[needleSize - 1];
+
+    for (int i = from; i <= last; ++i) {
+        if (haystack[i] == first && haystack[i + needleSize - 1] == tail && matchRest(haystack + i, needle, needleSize))
+            return i;
+    }
+
+    return -1;
+}
+
+#ifdef SEARCH_KERNEL_X86
+static int indexOfSse2(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, int from)
+{
+    const int last = haystackSize - needleSize;
+    const __m128i first = _mm_set1_epi16(short(needle[0]));
+    const __m128i tail = _mm_set1_epi16(short(needle[needleSize - 1]));
+
+    int i = from;
+    for (; i + 7 <= last; i += 8) {
+        const __m128i firstBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i));
+        const __m128i tailBlock = _mm_loadu_si128(reinterpret_cast<const __m128i *>(haystack + i + needleSize - 1));
+        const __m128i equal = _mm_and_si128(_mm_cmpeq_epi16(firstBlock, first), _mm_cmpeq_epi16(tailBlock, tail));
+
+        // 每个字符对应掩码中的两位
+        unsigned mask = unsigned(_mm_movemask_epi8(equal));
+        while (mask) {
+            const int bit = __builtin_ctz(mask);
+            const int pos = i + bit / 2;
+            if (matchRest(haystack + pos, needle, needleSize))
+                return pos;
+
+            mask &= ~(3u << bit);
+        }
+    }
+
+    return indexOfScalar(haystack, haystackSize, needle, needleSize, i);
+}
+
+__attribute__((target("avx2")))
+static int indexOfAvx2(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, int from)
+{
+    const int last = haystackSize - needleSize;
+    const __m256i first = _mm256_set1_epi16(short(needle[0]));
+    const __m256i tail = _mm256_set1_epi16(short(needle[needleSize - 1]));
+
+    int i = from;
+    for (; i + 15 <= last; i += 16) {
+        const __m256i firstBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i));
+        const __m256i tailBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(haystack + i + needleSize - 1));
+        const __m256i equal = _mm256_and_si256(_mm256_cmpeq_epi16(firstBlock, first), _mm256_cmpeq_epi16(tailBlock, tail));
+
+        unsigned mask = unsigned(_mm256_movemask_epi8(equal));
+        while (mask) {
+            const int bit = __builtin_ctz(mask);
+            const int pos = i + bit / 2;
+            if (matchRest(haystack + pos, needle, needleSize))
+                return pos;
+
+            mask &= ~(3u << bit);
+        }
+    }
+
+    return indexOfSse2(haystack, haystackSize, needle, needleSize, i);
+}
+#endif
+
+/**
+ * @brief SearchKernel::bestImplementation 当前 CPU 支持的最快实现, 只检测一次
+ */
+SearchKernel::Implementation SearchKernel::bestImplementation()
+{
+    static const Implementation implementation = [] {
+        if (isSupported(AVX2))
+            return AVX2;
+
+        if (isSupported(SSE2))
+            return SSE2;
+
+        return Scalar;
+    }();
+
+    return implementation;
+}
+
+bool SearchKernel::isSupported(const Implementation implementation)
+{
+    switch (implementation) {
+    case Scalar:
+        return true;
+#ifdef SEARCH_KERNEL_X86
+    case SSE2:
+        return true;
+    case AVX2: {
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2"));
+        return supported;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief SearchKernel::indexOf 查找子串第一次出现的位置
+ * @param haystack 小写的文本
+ * @param haystackSize 文本长度
+ * @param needle 小写的搜索内容
+ * @param needleSize 搜索内容长度
+ * @param from 开始查找的位置
+ * @return 子串的位置, 找不到时返回 -1
+ */
+int SearchKernel::indexOf(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, const int from)
+{
+    return indexOf(haystack, haystackSize, needle, needleSize, from, bestImplementation());
+}
+
+int SearchKernel::indexOf(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, const int from, const Implementation implementation)
+{
+    const int start = qMax(0, from);
+    if (needleSize <= 0)
+        return start <= haystackSize ? start : -1;
+
+    if (start > haystackSize - needleSize)
+        return -1;
+
+    switch (isSupported(implementation) ? implementation : Scalar) {
+#ifdef SEARCH_KERNEL_X86
+    case AVX2:
+        return indexOfAvx2(haystack, haystackSize, needle, needleSize, start);
+    case SSE2:
+        return indexOfSse2(haystack, haystackSize, needle, needleSize, start);
+#endif
+    default:
+        return indexOfScalar(haystack, haystackSize, needle, needleSize, start);
+    }
+}
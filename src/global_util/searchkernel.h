@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHKERNEL_H
+#define SEARCHKERNEL_H
+
+#include <QtGlobal>
+
+/**搜索子串匹配
+ * 文本与搜索内容均已预先转换为小写, 匹配时直接比较 UTF-16 编码,
+ * 在 x86 平台上使用 SSE2/AVX2 一次比较 8/16 个字符, 同时比较子串的首尾字符以筛选候选位置, 候选位置再逐个校验
+ * 运行时根据 CPU 支持的指令集选择实现, 其他平台使用普通实现
+ * @brief The SearchKernel class
+ */
+class SearchKernel
+{
+public:
+    enum Implementation {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    static int indexOf(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, const int from = 0);
+    static int indexOf(const ushort *haystack, const int haystackSize, const ushort *needle, const int needleSize, const int from, const Implementation implementation);
+
+    static Implementation bestImplementation();
+    static bool isSupported(const Implementation implementation);
+};
+
+#endif // SEARCHKERNEL_H
@@ -299,6 +299,23 @@ int perfectIconSize(const int size)
     return 256;
 }
 
+/**
+ * @brief appIconName 获取应用图标名称, 日历应用使用按当天日期生成的图标文件
+ * @param itemInfo 应用程序信息
+ * @return 图标名称或图标文件路径
+ */
+QString appIconName(const ItemInfo_v1 &itemInfo)
+{
+    if (!itemInfo.m_desktop.contains("/dde-calendar.desktop"))
+        return itemInfo.m_iconKey;
+
+    const QString name = QStandardPaths::standardLocations(QStandardPaths::TempLocation).first() + "/"
+            +  QString::number(QDate::currentDate().year())
+            + "_" + QString::number(QDate::currentDate().dayOfYear()) + ".svg";
+
+    return createCalendarIcon(name) ? name : itemInfo.m_iconKey;
+}
+
 /**
  * @brief getThemeIcon 从系统主题或者缓存中获取应用图标
  * @param pixmap 应用图标对象
@@ -309,23 +326,10 @@ int perfectIconSize(const int size)
  */
 bool getThemeIcon(QPixmap &pixmap, const ItemInfo_v1 &itemInfo, const int size)
 {
-    QString iconName;
+    const QString iconName = appIconName(itemInfo);
     QIcon icon;
     bool findIcon = true;
 
-    if (itemInfo.m_desktop.contains("/dde-calendar.desktop")) {
-        QString name = QStandardPaths::standardLocations(QStandardPaths::TempLocation).first() + "/"
-                +  QString::number(QDate::currentDate().year())
-                + "_" + QString::number(QDate::currentDate().dayOfYear()) + ".svg";
-
-        if (!createCalendarIcon(name))
-            iconName = itemInfo.m_iconKey;
-        else
-            iconName = name;
-    } else {
-        iconName = itemInfo.m_iconKey;
-    }
-
     const qreal ratio = qApp->devicePixelRatio();
     const int iconSize = perfectIconSize(size);
 
@@ -409,9 +413,20 @@ QIcon getIcon(const QString &name)
     return QIcon::fromTheme(getIconList(name).first());
 }
 
-QString cacheKey(const ItemInfo_v1 &itemInfo)
+/**
+ * @brief cacheKey 生成应用图标的缓存键
+ * @param itemInfo 应用程序信息
+ * @param size 应用图标大小, 按照 perfectIconSize 归档
+ * @param ratio 缩放比
+ * @return 缓存键, desktop 放在首位, 便于按应用移除缓存
+ */
+QString cacheKey(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio)
 {
-    return itemInfo.m_name + itemInfo.m_iconKey;
+    return QString("%1|%2|%3|%4|%5").arg(itemInfo.m_desktop)
+            .arg(itemInfo.m_iconKey)
+            .arg(perfectIconSize(size))
+            .arg(ratio)
+            .arg(QIcon::themeName());
 }
 
 DConfig *ConfigWorker::INSTANCE = Q_NULLPTR;
@@ -30,7 +30,8 @@ QString qtify_name(const char *name);
 QVariant SettingValue(const QString &schema_id, const QByteArray &path = QByteArray(), const QString &key = QString(), const QVariant &fallback = QVariant());
 bool createCalendarIcon(const QString &fileName);
 int perfectIconSize(const int size);
-QString cacheKey(const ItemInfo_v1 &itemInfo);
+QString cacheKey(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio);
+QString appIconName(const ItemInfo_v1 &itemInfo);
 bool getThemeIcon(QPixmap &pixmap, const ItemInfo_v1 &itemInfo, const int size);
 QIcon getIcon(const QString &name);
 
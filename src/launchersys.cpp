@@ -9,8 +9,10 @@
 #include "appsmanager.h"
 #include "util.h"
 #include "constants.h"
+#include "iconatlas.h"
 #include "amdbuslauncherinterface.h"
 #include "amdbusdockinterface.h"
+#include "dbusproxyregistry.h"
 
 #define SessionManagerService "org.deepin.dde.SessionManager1"
 #define SessionManagerPath "/org/deepin/dde/SessionManager1"
@@ -30,11 +32,14 @@ LauncherSys::LauncherSys(QObject *parent)
     , m_autoExitTimer(new QTimer(this))
     , m_ignoreRepeatVisibleChangeTimer(new QTimer(this))
     , m_calcUtil(CalculateUtil::instance())
-    , m_amDbusLauncher(new AMDBusLauncherInter(this))
-    , m_amDbusDockInter(new AMDBusDockInter(this))
+    , m_amDbusLauncher(DBusProxyRegistry::instance()->proxy<AMDBusLauncherInter>())
+    , m_amDbusDockInter(DBusProxyRegistry::instance()->proxy<AMDBusDockInter>())
     , m_launcherPlugin(new LauncherPluginController(this))
 {
     m_regionMonitor->setCoordinateType(Dtk::Gui::DRegionMonitor::Original);
+
+    // 启动时属性镜像的异步读取尚未返回, 同步读取一次全屏属性, 直接创建对应模式的窗口
+    m_calcUtil->setFullScreen(m_amDbusLauncher->fullscreen());
     displayModeChanged();
 
     m_autoExitTimer->setInterval(60 * 1000);
@@ -158,7 +163,13 @@ void LauncherSys::displayModeChanged()
 
 void LauncherSys::onVisibleChanged()
 {
-    emit visibleChanged(m_launcherInter->visible());
+    const bool visible = m_launcherInter->visible();
+
+    // 显示时在后台查询应用状态, 打开右键菜单时不再同步调用 D-Bus
+    if (visible)
+        m_appManager->prefetchAppStatus();
+
+    emit visibleChanged(visible);
 }
 
 void LauncherSys::onAutoExitTimeout()
@@ -166,6 +177,9 @@ void LauncherSys::onAutoExitTimeout()
     if (visible())
         return m_autoExitTimer->start();
 
+    // 隐藏一段时间后将本次渲染的图标写入磁盘, 下次冷启动直接使用
+    IconAtlas::instance()->save();
+
     if (SettingValue("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", "auto-exit", false).toBool()) {
         qWarning() << "Exit Timer timeout, may quitting...";
         qApp->quit();
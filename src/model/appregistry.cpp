@@ -0,0 +1,154 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appregistry.h"
+
+AppRegistry::AppRegistry(const ItemInfoList_v1 &list)
+    : m_list(list)
+{
+    reindex();
+}
+
+/**
+ * @brief AppRegistry::reindex 列表插入、删除或排序后重新记录各应用的行号
+ */
+void AppRegistry::reindex()
+{
+    m_rows.fill(-1);
+    m_keyRows.clear();
+    m_duplicateIds.clear();
+
+    m_keyRows.reserve(m_list.size());
+    for (int row = 0; row < m_list.size(); ++row)
+        indexRow(row);
+}
+
+/**
+ * @brief AppRegistry::indexAppendedRow 列表末尾追加应用后只记录新增的一行, 避免逐个追加时反复重建索引
+ */
+void AppRegistry::indexAppendedRow()
+{
+    if (!m_list.isEmpty())
+        indexRow(m_list.size() - 1);
+}
+
+/**
+ * @brief AppRegistry::indexRemovedRow 列表删除一行后只调整之后各行的行号, 避免卸载单个应用时重建哈希索引
+ * @param row 删除的行
+ * @param desktop 删除的应用的desktop全路径
+ * @param key 删除的应用的key
+ */
+void AppRegistry::indexRemovedRow(const int row, const QString &desktop, const QString &key)
+{
+    const AppId appId = id(desktop);
+    if (appId == InvalidId || m_duplicateIds.contains(appId)) {
+        reindex();
+        return;
+    }
+
+    m_rows[appId] = -1;
+    for (int &appRow : m_rows) {
+        if (appRow > row)
+            --appRow;
+    }
+
+    for (auto it = m_keyRows.begin(); it != m_keyRows.end(); ++it) {
+        if (it.value() > row)
+            --it.value();
+    }
+
+    // 删除的是第一个使用该 key 的应用时, 由之后使用该 key 的应用代替
+    if (m_keyRows.value(key, -1) == row) {
+        m_keyRows.remove(key);
+        for (int i = row; i < m_list.size(); ++i) {
+            if (m_list.at(i).m_key == key) {
+                m_keyRows.insert(key, i);
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief AppRegistry::id 获取应用的固定 id
+ * @param desktop 应用的desktop全路径
+ * @return 应用的 id, 从未出现在列表中时返回 InvalidId
+ */
+AppRegistry::AppId AppRegistry::id(const QString &desktop) const
+{
+    return m_ids.value(desktop, AppId(InvalidId));
+}
+
+/**
+ * @brief AppRegistry::row 获取 id 对应的应用当前所在的行
+ * @return 行号, 应用不在列表中时返回 -1
+ */
+int AppRegistry::row(const AppId id) const
+{
+    return (id >= 0 && id < m_rows.size()) ? m_rows.at(id) : -1;
+}
+
+int AppRegistry::indexOf(const QString &desktop) const
+{
+    return row(id(desktop));
+}
+
+/**
+ * @brief AppRegistry::indexOf 查找与 item 相似的应用所在的行, 结果与逐个调用 ItemInfo_v1::isSimilar 查找一致
+ * @param item 应用信息
+ * @return 行号, 不存在时返回 -1
+ */
+int AppRegistry::indexOf(const ItemInfo_v1 &item) const
+{
+    const AppId appId = id(item.m_desktop);
+    if (appId == InvalidId)
+        return -1;
+
+    if (m_duplicateIds.contains(appId)) {
+        for (int i = 0; i < m_list.size(); ++i) {
+            if (m_list.at(i).isSimilar(item))
+                return i;
+        }
+
+        return -1;
+    }
+
+    const int index = row(appId);
+    return (index != -1 && m_list.at(index).isSimilar(item)) ? index : -1;
+}
+
+/**
+ * @brief AppRegistry::indexOfKey 查找第一个使用 key 的应用所在的行
+ * @param key 应用的key
+ * @return 行号, 不存在时返回 -1
+ */
+int AppRegistry::indexOfKey(const QString &key) const
+{
+    return m_keyRows.value(key, -1);
+}
+
+bool AppRegistry::contains(const ItemInfo_v1 &item) const
+{
+    return indexOf(item) != -1;
+}
+
+void AppRegistry::indexRow(const int row)
+{
+    const ItemInfo_v1 &info = m_list.at(row);
+
+    AppId appId = id(info.m_desktop);
+    if (appId == InvalidId) {
+        appId = m_rows.size();
+        m_ids.insert(info.m_desktop, appId);
+        m_rows.append(-1);
+    }
+
+    if (m_rows.at(appId) == -1)
+        m_rows[appId] = row;
+    else
+        m_duplicateIds.insert(appId);
+
+    if (!m_keyRows.contains(info.m_key))
+        m_keyRows.insert(info.m_key, row);
+}
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPREGISTRY_H
+#define APPREGISTRY_H
+
+#include "iteminfo.h"
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+
+/**应用列表索引
+ * 以 desktop 全路径为主键、key 为辅键为应用列表建立哈希索引, 查找应用所在行时不再逐个调用 ItemInfo_v1::isSimilar
+ * 每个 desktop 分配一个固定的 id, 列表重新生成或排序后 id 不变, 只更新 id 对应的行号
+ * 索引只记录行号, 列表的插入、删除及排序需要调用 reindex() 同步, 原地更新应用信息则不需要
+ * @brief The AppRegistry class
+ */
+class AppRegistry
+{
+public:
+    typedef int AppId;
+    enum { InvalidId = -1 };
+
+    explicit AppRegistry(const ItemInfoList_v1 &list);
+
+    void reindex();
+    void indexAppendedRow();
+    void indexRemovedRow(const int row, const QString &desktop, const QString &key);
+
+    AppId id(const QString &desktop) const;
+    int row(const AppId id) const;
+    int indexOf(const QString &desktop) const;
+    int indexOf(const ItemInfo_v1 &item) const;
+    int indexOfKey(const QString &key) const;
+    bool contains(const ItemInfo_v1 &item) const;
+
+private:
+    void indexRow(const int row);
+
+private:
+    const ItemInfoList_v1 &m_list;
+
+    QHash<QString, AppId> m_ids;                        // desktop -> id, id 一经分配不再变化
+    QVector<int> m_rows;                                // id -> 行号, 不在列表中时为 -1
+    QHash<QString, int> m_keyRows;                      // key -> 第一个使用该 key 的应用的行号
+    QSet<AppId> m_duplicateIds;                         // 列表中重复出现的 desktop, 查找时退化为逐个比较
+};
+
+#endif // APPREGISTRY_H
@@ -0,0 +1,338 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appsearchindex.h"
+#include "languagetranformation.h"
+#include "searchkernel.h"
+
+#include <QDateTime>
+#include <QFileInfo>
+
+#include <cmath>
+
+static const QChar FIELD_SEPARATOR = QLatin1Char('\n');
+static const int MIN_TYPO_LENGTH = 4;           // 搜索内容过短时容错匹配的结果过多, 不做容错
+static const int MAX_TYPO_LENGTH = 32;
+static const int USAGE_UNIT_TIME = 3600;        // 与 AppsManager::sortByUseFrequence 一致, 以小时为单位计算平均打开次数
+static const int MAX_USAGE_SCORE = 99;          // 小于两档匹配之间的差值, 使用频率只影响同一档内的排序
+
+/**
+ * @brief fieldWeight 字段加分, 名称及其拼音优先于 key 和 desktop 文件名, 关键字不加分
+ * @param fieldIndex 字段在搜索文本中的序号, 与 searchText() 中的顺序一致
+ */
+static int fieldWeight(const int fieldIndex)
+{
+    switch (fieldIndex) {
+    case 0:                 // 名称
+    case 3:                 // 全拼
+    case 4:                 // 简拼
+        return 100;
+    case 1:                 // key
+    case 2:                 // desktop 文件名
+        return 50;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief withinOneEdit 判断搜索内容与字段中的某个子串的编辑距离是否不超过1
+ */
+static bool withinOneEdit(const QStringRef &field, const QString &lowerText)
+{
+    const int length = lowerText.size();
+    int previous[MAX_TYPO_LENGTH + 1];
+    int current[MAX_TYPO_LENGTH + 1];
+
+    for (int i = 0; i <= length; ++i)
+        previous[i] = i;
+
+    // 子串可以从字段的任意位置开始, 因此每一列的第0行均为0
+    for (const QChar &ch : field) {
+        current[0] = 0;
+        for (int i = 1; i <= length; ++i) {
+            const int substitution = previous[i - 1] + (lowerText.at(i - 1) == ch ? 0 : 1);
+            current[i] = qMin(substitution, qMin(previous[i], current[i - 1]) + 1);
+        }
+
+        if (current[length] <= 1)
+            return true;
+
+        std::copy(current, current + length + 1, previous);
+    }
+
+    return false;
+}
+
+/**
+ * @brief fieldMatchScore 计算搜索内容在单个字段中的匹配档位
+ */
+static int fieldMatchScore(const QStringRef &field, const QString &lowerText)
+{
+    const ushort *fieldData = reinterpret_cast<const ushort *>(field.unicode());
+    auto indexOf = [ & ](const int from) {
+        return SearchKernel::indexOf(fieldData, field.size(), lowerText.utf16(), lowerText.size(), from);
+    };
+
+    int score = AppSearchIndex::NoMatch;
+    for (int pos = indexOf(0); pos != -1; pos = indexOf(pos + 1)) {
+        if (pos == 0)
+            return AppSearchIndex::PrefixMatch;
+
+        if (!field.at(pos - 1).isLetterOrNumber())
+            return AppSearchIndex::WordMatch;
+
+        score = AppSearchIndex::SubstringMatch;
+    }
+
+    if (score != AppSearchIndex::NoMatch)
+        return score;
+
+    int matched = 0;
+    for (const QChar &ch : field) {
+        if (ch == lowerText.at(matched) && ++matched == lowerText.size())
+            return AppSearchIndex::SubsequenceMatch;
+    }
+
+    if (lowerText.size() >= MIN_TYPO_LENGTH && lowerText.size() <= MAX_TYPO_LENGTH && withinOneEdit(field, lowerText))
+        return AppSearchIndex::TypoMatch;
+
+    return AppSearchIndex::NoMatch;
+}
+
+QPointer<AppSearchIndex> AppSearchIndex::INSTANCE = nullptr;
+
+AppSearchIndex *AppSearchIndex::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new AppSearchIndex;
+
+    return INSTANCE;
+}
+
+AppSearchIndex::AppSearchIndex(QObject *parent)
+    : QObject(parent)
+{
+    // 拼音库在后台线程中加载, 加载完成前生成的索引不含拼音, 需要重新生成
+    connect(LanguageTransformation::instance(), &LanguageTransformation::configLoaded, this, &AppSearchIndex::onLanguageConfigLoaded);
+}
+
+/**
+ * @brief AppSearchIndex::searchText 生成应用的搜索文本
+ * @param info 应用信息
+ * @return 小写的名称、key、desktop 文件名、全拼、简拼及关键字, 以换行符分隔
+ */
+QString AppSearchIndex::searchText(const ItemInfo_v1 &info)
+{
+    LanguageTransformation *transformation = LanguageTransformation::instance();
+
+    QStringList fields;
+    fields.reserve(5 + info.m_keywords.size());
+    fields << info.m_name
+           << info.m_key
+           << QFileInfo(info.m_desktop).completeBaseName()
+           << transformation->zhToPinYin(info.m_name)
+           << transformation->zhToJianPin(info.m_name)
+           << info.m_keywords;
+
+    return fields.join(FIELD_SEPARATOR).toLower();
+}
+
+/**
+ * @brief AppSearchIndex::rebuild 根据应用列表重新生成索引, 名称、key 及关键字未变化的应用沿用原有的索引项
+ * @param list 所有应用列表
+ */
+void AppSearchIndex::rebuild(const ItemInfoList_v1 &list)
+{
+    QHash<QString, Entry> entries;
+    entries.reserve(list.size());
+
+    for (const ItemInfo_v1 &info : list) {
+        auto it = m_entries.constFind(info.m_desktop);
+        if (it != m_entries.constEnd() && it->name == info.m_name && it->key == info.m_key && it->keywords == info.m_keywords) {
+            entries.insert(info.m_desktop, it.value());
+            continue;
+        }
+
+        Entry entry;
+        entry.name = info.m_name;
+        entry.key = info.m_key;
+        entry.keywords = info.m_keywords;
+        entry.text = searchText(info);
+        entry.usageScore = it != m_entries.constEnd() ? it->usageScore : usageScore(info.m_openCount, info.m_firstRunTime);
+        entries.insert(info.m_desktop, entry);
+    }
+
+    m_entries.swap(entries);
+}
+
+/**
+ * @brief AppSearchIndex::update 应用安装或更新后更新其索引项
+ * @param info 应用信息
+ */
+void AppSearchIndex::update(const ItemInfo_v1 &info)
+{
+    if (info.m_desktop.isEmpty())
+        return;
+
+    const bool exists = m_entries.contains(info.m_desktop);
+    Entry &entry = m_entries[info.m_desktop];
+    entry.name = info.m_name;
+    entry.key = info.m_key;
+    entry.keywords = info.m_keywords;
+    entry.text = searchText(info);
+
+    if (!exists || info.m_openCount > 0)
+        entry.usageScore = usageScore(info.m_openCount, info.m_firstRunTime);
+}
+
+/**
+ * @brief AppSearchIndex::updateUsage 应用启动后更新使用频率加分
+ * @param info 应用信息
+ */
+void AppSearchIndex::updateUsage(const ItemInfo_v1 &info)
+{
+    auto it = m_entries.find(info.m_desktop);
+    if (it != m_entries.end())
+        it->usageScore = usageScore(info.m_openCount, info.m_firstRunTime);
+}
+
+/**
+ * @brief AppSearchIndex::updateUsage 从缓存的应用列表中读取打开次数, 更新使用频率加分
+ * @param list 带有打开次数及首次启动时间的应用列表
+ */
+void AppSearchIndex::updateUsage(const ItemInfoList_v1 &list)
+{
+    for (const ItemInfo_v1 &info : list)
+        updateUsage(info);
+}
+
+/**
+ * @brief AppSearchIndex::remove 应用卸载后移除其索引项
+ * @param desktop 应用的desktop全路径
+ */
+void AppSearchIndex::remove(const QString &desktop)
+{
+    m_entries.remove(desktop);
+}
+
+/**
+ * @brief AppSearchIndex::score 计算应用与搜索内容的匹配分数
+ * @param desktop 应用的desktop全路径
+ * @param lowerText 小写的搜索内容
+ * @return 匹配档位、字段加分与使用频率加分之和, 不匹配或应用不在索引中时返回0
+ */
+int AppSearchIndex::score(const QString &desktop, const QString &lowerText) const
+{
+    auto it = m_entries.constFind(desktop);
+    if (it == m_entries.constEnd())
+        return NoMatch;
+
+    const int matched = matchScore(it->text, lowerText);
+    return matched == NoMatch ? NoMatch : matched + it->usageScore;
+}
+
+/**
+ * @brief AppSearchIndex::score 计算应用与搜索内容的匹配分数, 应用不在索引中时临时生成搜索文本
+ * @param info 应用信息
+ * @param lowerText 小写的搜索内容
+ * @return 匹配分数, 不匹配时返回0
+ */
+int AppSearchIndex::score(const ItemInfo_v1 &info, const QString &lowerText) const
+{
+    if (contains(info.m_desktop))
+        return score(info.m_desktop, lowerText);
+
+    const int matched = matchScore(searchText(info), lowerText);
+    return matched == NoMatch ? NoMatch : matched + usageScore(info.m_openCount, info.m_firstRunTime);
+}
+
+/**
+ * @brief AppSearchIndex::matchScore 计算搜索内容在搜索文本中的最佳匹配分数
+ * @param text searchText() 生成的搜索文本
+ * @param lowerText 小写的搜索内容
+ * @return 各字段中最高的匹配档位与字段加分之和, 不匹配时返回0
+ */
+int AppSearchIndex::matchScore(const QString &text, const QString &lowerText)
+{
+    if (lowerText.isEmpty())
+        return PrefixMatch;
+
+    int bestScore = NoMatch;
+    int fieldIndex = 0;
+    int start = 0;
+
+    while (start <= text.size()) {
+        int end = text.indexOf(FIELD_SEPARATOR, start);
+        if (end == -1)
+            end = text.size();
+
+        const int weight = fieldWeight(fieldIndex);
+        if (end - start > 0 && bestScore < PrefixMatch + weight) {
+            const int matched = fieldMatchScore(text.midRef(start, end - start), lowerText);
+            if (matched != NoMatch)
+                bestScore = qMax(bestScore, matched + weight);
+        }
+
+        start = end + 1;
+        ++fieldIndex;
+    }
+
+    return bestScore;
+}
+
+/**
+ * @brief AppSearchIndex::isNarrowing 判断新的搜索内容的结果是否一定是之前搜索内容结果的子集
+ * 在之前的内容后追加字符时通常如此, 但长度达到容错匹配的最小长度时会出现新的容错匹配结果
+ * @param lowerText 之前的小写搜索内容
+ * @param newLowerText 新的小写搜索内容
+ * @return 是否可以只在之前的结果中筛选
+ */
+bool AppSearchIndex::isNarrowing(const QString &lowerText, const QString &newLowerText)
+{
+    if (lowerText.isEmpty() || !newLowerText.startsWith(lowerText))
+        return false;
+
+    return lowerText.size() >= MIN_TYPO_LENGTH || newLowerText.size() < MIN_TYPO_LENGTH;
+}
+
+/**
+ * @brief AppSearchIndex::usageScore 根据平均每小时的打开次数计算使用频率加分
+ * @param openCount 打开次数
+ * @param firstRunTime 首次启动的时间戳(秒)
+ * @return 0 ~ 99 的加分
+ */
+int AppSearchIndex::usageScore(const qlonglong openCount, const qlonglong firstRunTime)
+{
+    if (openCount <= 0)
+        return 0;
+
+    const qint64 currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+    const qint64 hoursDiff = (firstRunTime > 0 && firstRunTime <= currentTime) ? (currentTime - firstRunTime) / USAGE_UNIT_TIME + 1 : 1;
+    const double rate = static_cast<double>(openCount) / hoursDiff;
+
+    return qMin(MAX_USAGE_SCORE, qRound(40 * std::log2(1.0 + 10 * rate)));
+}
+
+bool AppSearchIndex::contains(const QString &desktop) const
+{
+    return m_entries.contains(desktop);
+}
+
+int AppSearchIndex::count() const
+{
+    return m_entries.size();
+}
+
+void AppSearchIndex::onLanguageConfigLoaded()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        ItemInfo_v1 info;
+        info.m_desktop = it.key();
+        info.m_name = it->name;
+        info.m_key = it->key;
+        info.m_keywords = it->keywords;
+        it->text = searchText(info);
+    }
+}
@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPSEARCHINDEX_H
+#define APPSEARCHINDEX_H
+
+#include "iteminfo.h"
+
+#include <QObject>
+#include <QHash>
+#include <QPointer>
+
+/**应用搜索索引
+ * 每个应用的名称、key、desktop 文件名、全拼、简拼及关键字预先转换为小写并拼接为一段连续的文本,
+ * 搜索时只需在其中匹配, 不再逐行进行拼音转换
+ * 匹配结果按照 前缀 > 单词开头 > 子串 > 子序列 > 单个错字 分档评分, 同一档内再按字段及使用频率排序
+ * @brief The AppSearchIndex class
+ */
+class AppSearchIndex : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum MatchScore {
+        NoMatch = 0,
+        TypoMatch = 200,                    // 与某个字段的子串相差一个字符
+        SubsequenceMatch = 400,             // 按顺序出现在同一个字段中
+        SubstringMatch = 600,               // 字段中间的子串
+        WordMatch = 800,                    // 字段中某个单词的开头
+        PrefixMatch = 1000                  // 字段的开头
+    };
+
+    static AppSearchIndex *instance();
+
+    void rebuild(const ItemInfoList_v1 &list);
+    void update(const ItemInfo_v1 &info);
+    void updateUsage(const ItemInfo_v1 &info);
+    void updateUsage(const ItemInfoList_v1 &list);
+    void remove(const QString &desktop);
+
+    int score(const QString &desktop, const QString &lowerText) const;
+    int score(const ItemInfo_v1 &info, const QString &lowerText) const;
+    bool contains(const QString &desktop) const;
+    int count() const;
+
+    static QString searchText(const ItemInfo_v1 &info);
+    static int matchScore(const QString &text, const QString &lowerText);
+    static bool isNarrowing(const QString &lowerText, const QString &newLowerText);
+    static int usageScore(const qlonglong openCount, const qlonglong firstRunTime);
+
+private:
+    explicit AppSearchIndex(QObject *parent = nullptr);
+
+    void onLanguageConfigLoaded();
+
+private:
+    struct Entry
+    {
+        QString name;
+        QString key;
+        QStringList keywords;
+        QString text;                       // 小写的搜索文本, 各字段以换行符分隔
+        int usageScore;                     // 使用频率加分
+    };
+
+    static QPointer<AppSearchIndex> INSTANCE;
+
+    QHash<QString, Entry> m_entries;        // desktop -> 索引项
+};
+
+#endif // APPSEARCHINDEX_H
@@ -47,6 +47,14 @@ static QGSettings *gSetting = SettingsPtr("com.deepin.dde.launcher", "/com/deepi
 static QStringList hideUseProxyPackages(sysHideUseProxyPackages());
 static QStringList cantUseProxyPackages(sysCantUseProxyPackages());
 
+// 一次更新中移动的行超过该数量时(如重新排序)整体刷新, 不再逐行通知
+static const int MAX_MOVED_ROWS = 16;
+
+static uint hashCombine(uint seed, uint value)
+{
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
 const QStringList sysHideOpenPackages()
 {
     QStringList hideOpen_list;
@@ -210,17 +218,38 @@ AppsListModel::AppsListModel(const AppCategory &category, QObject *parent)
     , m_category(category)
     , m_drawBackground(true)
     , m_pageIndex(0)
+    , m_updatingRows(false)
+    , m_rowsOutdated(false)
 {
+    m_rows = currentRows();
+
     connect(m_appsManager, &AppsManager::dataChanged, this, &AppsListModel::dataChanged);
     connect(m_appsManager, &AppsManager::layoutChanged, this, &AppsListModel::layoutChanged);
     connect(m_appsManager, &AppsManager::itemDataChanged, this, &AppsListModel::itemDataChanged);
+    connect(m_appsManager, &AppsManager::itemInserted, this, &AppsListModel::itemRowsChanged);
+    connect(m_appsManager, &AppsManager::itemRemoved, this, &AppsListModel::itemRowsChanged);
+
+    // 每页显示的个数变化后, 当前页包含的应用随之变化
+    connect(m_calcUtil, &CalculateUtil::layoutChanged, this, &AppsListModel::updateRows);
+}
+
+void AppsListModel::setPageIndex(int pageIndex)
+{
+    if (m_pageIndex == pageIndex)
+        return;
+
+    beginResetModel();
+    m_pageIndex = pageIndex;
+    m_rows = currentRows();
+    endResetModel();
 }
 
 void AppsListModel::setCategory(const AppsListModel::AppCategory category)
 {
+    beginResetModel();
     m_category = category;
-
-    emit QAbstractListModel::layoutChanged();
+    m_rows = currentRows();
+    endResetModel();
 }
 
 /**
@@ -252,13 +281,12 @@ void AppsListModel::setDragDropIndex(const QModelIndex &index)
  */
 void AppsListModel::dropInsert(const QString &desktop, const int pos)
 {
-    beginInsertRows(QModelIndex(), pos, pos);
     int appPos = pos;
     if ((m_category == AppsListModel::FullscreenAll) || (m_category == AppsListModel::Dir))
         appPos = m_pageIndex * m_calcUtil->appPageItemCount(m_category) + pos;
 
     m_appsManager->restoreItem(desktop, m_category, appPos);
-    endInsertRows();
+    updateRows();
 }
 
 /**在当前模型指定的位置插入应用
@@ -267,19 +295,16 @@ void AppsListModel::dropInsert(const QString &desktop, const int pos)
  */
 void AppsListModel::insertItem(int pos)
 {
-    beginInsertRows(QModelIndex(), pos, pos);
-
     pos += m_appsManager->getPageIndex() * m_calcUtil->appPageItemCount(m_appsManager->getCategory());
 
     m_appsManager->insertDropItem(pos);
-    endInsertRows();
+    updateRows();
 }
 
 void AppsListModel::insertItem(const ItemInfo_v1 &item, const int pos)
 {
-    beginInsertRows(QModelIndex(), pos, pos);
     m_appsManager->dropToCollected(item, pos);
-    endInsertRows();
+    updateRows();
 }
 
 /**
@@ -329,21 +354,51 @@ int AppsListModel::rowCount(const QModelIndex &parent) const
 {
     Q_UNUSED(parent)
 
+    // 逐步通知视图的过程中, 行数与已通知的变化保持一致
+    if (m_updatingRows)
+        return m_rows.size();
+
+    return pageRowCount();
+}
+
+/**
+ * @brief AppsListModel::pageRowCount 当前页在 AppsManager 列表中实际包含的应用个数
+ */
+int AppsListModel::pageRowCount() const
+{
     int nSize = m_appsManager->appsInfoListSize(m_category);
     int pageCount = m_calcUtil->appPageItemCount(m_category);
     int nPageCount = nSize - pageCount * m_pageIndex;
     nPageCount = nPageCount > 0 ? nPageCount : 0;
 
-    if(!m_calcUtil->fullscreen())
-        return nSize;
-
-    if (m_category == AppsListModel::Favorite || (m_category == AppsListModel::Search)
-                              || (m_category == AppsListModel::PluginSearch))
+    if (!isPaged())
         return nSize;
 
     return qMin(pageCount, nPageCount);
 }
 
+/**
+ * @brief AppsListModel::isPaged 全屏时除收藏及搜索外的列表按页显示, 模型只包含当前页的应用
+ */
+bool AppsListModel::isPaged() const
+{
+    if (!m_calcUtil->fullscreen())
+        return false;
+
+    return m_category != AppsListModel::Favorite && m_category != AppsListModel::Search
+            && m_category != AppsListModel::PluginSearch;
+}
+
+/**
+ * @brief AppsListModel::showsList 模型是否显示该分类的列表, 搜索模型在小窗口所有应用的列表中搜索,
+ * 该列表变化时搜索模型的行同样变化
+ * @param category 发生变化的列表的分类
+ */
+bool AppsListModel::showsList(const AppsListModel::AppCategory category) const
+{
+    return category == m_category || (category == WindowedAll && m_category == Search);
+}
+
 /**
  * @brief AppsListModel::indexAt 根据appkey值返回app所在的模型索引
  * @param appKey app key
@@ -406,9 +461,8 @@ bool AppsListModel::removeRows(int row, int count, const QModelIndex &parent)
         return false;
     }
 
-    beginRemoveRows(parent, row, row);
     m_appsManager->dragdropStashItem(index(row), m_category);
-    endRemoveRows();
+    updateRows();
 
     return true;
 }
@@ -471,45 +525,114 @@ QMimeData *AppsListModel::mimeData(const QModelIndexList &indexes) const
 }
 
 /**
- * @brief AppsListModel::data 获取给定模型索引和数据角色的item数据
+ * @brief AppsListModel::itemRow 获取模型索引对应的应用在 AppsManager 列表中的位置
  * @param index item对应的模型索引
- * @param role item对应的数据角色
- * @return 返回item相关的数据
+ * @return 应用在列表中的位置, 索引无效或超出当前页时返回 -1
  */
-QVariant AppsListModel::data(const QModelIndex &index, int role) const
+int AppsListModel::itemRow(const QModelIndex &index) const
 {
-    ItemInfo_v1 itemInfo = ItemInfo_v1();
-    int nSize = m_appsManager->appsInfoListSize(m_category);
-    int nFixCount = m_calcUtil->appPageItemCount(m_category);
+    if (!index.isValid())
+        return -1;
+
+    const int nSize = m_appsManager->appsInfoListSize(m_category);
+    const int nFixCount = m_calcUtil->appPageItemCount(m_category);
     int pageCount = qMin(nFixCount, nSize - nFixCount * m_pageIndex);
+    int start = 0;
 
-    if(!m_calcUtil->fullscreen()) {
+    // 小窗口及搜索原数据模型中的数据未经过翻页处理
+    if (!m_calcUtil->fullscreen() || (m_category == Search) || (m_category == PluginSearch))
         pageCount = nSize;
-        if (m_category == TitleMode)
-            itemInfo = m_appsManager->appsCategoryListIndex(index.row());
-        else if (m_category == LetterMode) {
-            itemInfo = m_appsManager->appsLetterListIndex(index.row());
-        } else if (m_category == WindowedAll) {
-            itemInfo = m_appsManager->appsInfoListIndex(m_category, index.row());
-        } else if (m_category == Favorite) {
-            itemInfo = m_appsManager->appsInfoListIndex(m_category, index.row());
-        } else if ((m_category == Search) || (m_category == PluginSearch)) {
-            itemInfo = m_appsManager->appsInfoListIndex(m_category, index.row());
-        }
-    } else {
-        if ((m_category == Search) || (m_category == PluginSearch)) {
-            // 保证搜索原数据模型中的数据未经过翻页处理
-            pageCount = nSize;
-            itemInfo = m_appsManager->appsInfoListIndex(m_category, index.row());
-        } else {
-            int start = nFixCount * m_pageIndex;
-            itemInfo = m_appsManager->appsInfoListIndex(m_category, start + index.row());
+    else
+        start = nFixCount * m_pageIndex;
+
+    return index.row() < pageCount ? start + index.row() : -1;
+}
+
+/**
+ * @brief AppsListModel::itemInfoAt 获取应用信息, 直接引用 AppsManager 中的数据, 不复制
+ * @param row itemRow() 返回的位置
+ * @return 应用信息, 不存在时返回 nullptr
+ */
+const ItemInfo_v1 *AppsListModel::itemInfoAt(const int row) const
+{
+    if (!m_calcUtil->fullscreen()) {
+        switch (m_category) {
+        case TitleMode:
+        case LetterMode:
+        case WindowedAll:
+        case Favorite:
+        case Search:
+        case PluginSearch:
+            break;
+        default:
+            return nullptr;
         }
     }
 
-    if (!index.isValid() || index.row() >= pageCount)
+    return m_appsManager->appsInfoListItem(m_category, row);
+}
+
+/**
+ * @brief AppsListModel::rowSnapshot 一次性生成绘制 item 所需的数据
+ * @param index item对应的模型索引
+ * @param itemInfo 应用信息
+ * @return item 的绘制数据
+ */
+const AppsListModel::RowSnapshot AppsListModel::rowSnapshot(const QModelIndex &index, const ItemInfo_v1 &itemInfo) const
+{
+    RowSnapshot snapshot;
+    snapshot.displayName = itemInfo.m_isDir ? itemInfo.m_name : m_appsManager->appDisplayName(itemInfo);
+    snapshot.description = itemInfo.m_description;
+    snapshot.iconSize = m_calcUtil->appIconSize(m_category);
+    snapshot.icon = m_appsManager->appIcon(itemInfo, snapshot.iconSize.width());
+    snapshot.fontPixelSize = DFontSizeManager::instance()->fontPixelSize(DFontSizeManager::T6);
+    snapshot.status = itemInfo.m_status;
+    snapshot.progressValue = itemInfo.m_progressValue;
+    snapshot.dirItemCount = itemInfo.m_appInfoList.size();
+    snapshot.isDir = itemInfo.m_isDir;
+    snapshot.isTitle = itemInfo.m_iconKey.isEmpty();
+    snapshot.isNewInstall = m_appsManager->appIsNewInstall(itemInfo.m_key);
+    snapshot.isAutoStart = m_appsManager->appIsAutoStart(itemInfo.m_desktop);
+    snapshot.isDragging = indexDragging(index);
+    snapshot.drawBackground = m_drawBackground;
+
+    return snapshot;
+}
+
+/**
+ * @brief AppsListModel::data 获取给定模型索引和数据角色的item数据
+ * @param index item对应的模型索引
+ * @param role item对应的数据角色
+ * @return 返回item相关的数据
+ */
+QVariant AppsListModel::data(const QModelIndex &index, int role) const
+{
+    const int row = itemRow(index);
+    if (row == -1)
         return QVariant();
 
+    // 只与布局相关的数据不需要获取应用信息
+    switch (role) {
+    case ItemSizeHintRole:
+        return m_calcUtil->appItemSize();
+    case AppIconSizeRole:
+        return m_calcUtil->appIconSize(m_category);
+    case AppFontSizeRole:
+        return DFontSizeManager::instance()->fontPixelSize(DFontSizeManager::T6);
+    case AppItemIsDraggingRole:
+        return indexDragging(index);
+    case DrawBackgroundRole:
+        return m_drawBackground;
+    case AppGroupRole:
+        return QVariant::fromValue(m_category);
+    default:
+        break;
+    }
+
+    static const ItemInfo_v1 emptyItemInfo;
+    const ItemInfo_v1 *info = itemInfoAt(row);
+    const ItemInfo_v1 &itemInfo = info ? *info : emptyItemInfo;
+
     switch (role) {
     case AppRawItemInfoRole:
         return QVariant::fromValue(itemInfo);
@@ -519,42 +642,32 @@ QVariant AppsListModel::data(const QModelIndex &index, int role) const
         return itemInfo.m_desktop;
     case AppKeyRole:
         return itemInfo.m_key;
-    case AppGroupRole:
-        return QVariant::fromValue(m_category);
+    case AppRowSnapshotRole:
+        return QVariant::fromValue(rowSnapshot(index, itemInfo));
     case AppAutoStartRole:
         return m_appsManager->appIsAutoStart(itemInfo.m_desktop);
     case AppIsOnDesktopRole:
-        return m_appsManager->appIsOnDesktop(itemInfo.m_key);
+        return m_appsManager->appIsOnDesktop(itemInfo);
     case AppIsOnDockRole:
-        return m_appsManager->appIsOnDock(itemInfo.m_desktop);
+        return m_appsManager->appIsOnDock(itemInfo);
     case AppIsRemovableRole:
         return !m_holdPackages.contains(itemInfo.m_key);
     case AppIsProxyRole:
-        return m_appsManager->appIsProxy(itemInfo.m_key);
+        return m_appsManager->appIsProxy(itemInfo);
     case AppEnableScalingRole:
-        return m_appsManager->appIsEnableScaling(itemInfo.m_key);
+        return m_appsManager->appIsEnableScaling(itemInfo);
     case AppNewInstallRole:
         return m_appsManager->appIsNewInstall(itemInfo.m_key);
     case AppIconRole:
         return m_appsManager->appIcon(itemInfo, m_calcUtil->appIconSize(m_category).width());
     case AppDialogIconRole:
-        return m_appsManager->appIcon(itemInfo, DLauncher::APP_DLG_ICON_SIZE);
+        return m_appsManager->syncAppIcon(itemInfo, DLauncher::APP_DLG_ICON_SIZE);
     case AppDragIconRole:
-        return m_appsManager->appIcon(itemInfo, m_calcUtil->appIconSize(m_category).width() * 1.2);
+        return m_appsManager->syncAppIcon(itemInfo, m_calcUtil->appIconSize(m_category).width() * 1.2);
     case AppListIconRole: {
         QSize iconSize = m_calcUtil->appIconSize(m_category);
         return m_appsManager->appIcon(itemInfo, iconSize.width());
     }
-    case ItemSizeHintRole:
-        return m_calcUtil->appItemSize();
-    case AppIconSizeRole:
-        return m_calcUtil->appIconSize(m_category);
-    case AppFontSizeRole:
-        return DFontSizeManager::instance()->fontPixelSize(DFontSizeManager::T6);
-    case AppItemIsDraggingRole:
-        return indexDragging(index);
-    case DrawBackgroundRole:
-        return m_drawBackground;
     case AppHideOpenRole:
         return (m_actionSettings && !m_actionSettings->get("open").toBool()) || m_hideOpenPackages.contains(itemInfo.m_key);
     case AppHideSendToDesktopRole:
@@ -628,8 +741,8 @@ Qt::ItemFlags AppsListModel::flags(const QModelIndex &index) const
 ///
 void AppsListModel::dataChanged(const AppCategory category)
 {
-    if (category == FullscreenAll || category == m_category)
-        emit QAbstractItemModel::layoutChanged();
+    if (category == FullscreenAll || showsList(category))
+        updateRows();
 }
 
 ///
@@ -642,6 +755,180 @@ void AppsListModel::layoutChanged(const AppsListModel::AppCategory category)
         emit QAbstractItemModel::dataChanged(QModelIndex(), QModelIndex());
 }
 
+/**
+ * @brief AppsListModel::itemRowsChanged 应用列表中插入或移除一个应用后通知视图对应的行
+ * 按页显示时插入或移除位置之后的应用会在相邻的页之间移动, 与当前页原有的各行比较后通知
+ * @param category 应用列表的类型
+ */
+void AppsListModel::itemRowsChanged(const AppsListModel::AppCategory category)
+{
+    if (showsList(category))
+        updateRows();
+}
+
+/**
+ * @brief AppsListModel::rowState 记录应用在视图中的显示内容, 用于判断该行是否需要重绘
+ * @param info 应用信息
+ * @return 行的状态
+ */
+AppsListModel::RowState AppsListModel::rowState(const ItemInfo_v1 &info) const
+{
+    RowState state;
+    state.id = info.m_desktop;
+    state.status = info.m_status;
+    state.progressValue = info.m_progressValue;
+
+    uint hash = qHash(info.m_name);
+    hash = hashCombine(hash, qHash(info.m_key));
+    hash = hashCombine(hash, qHash(info.m_iconKey));
+    hash = hashCombine(hash, qHash(info.m_description));
+    hash = hashCombine(hash, uint(info.m_isDir));
+    hash = hashCombine(hash, uint(m_appsManager->appIsNewInstall(info.m_key)));
+    hash = hashCombine(hash, uint(m_appsManager->appIsAutoStart(info.m_desktop)));
+    for (const ItemInfo_v1 &dirItemInfo : info.m_appInfoList)
+        hash = hashCombine(hash, qHash(dirItemInfo.m_desktop));
+
+    state.contentHash = hash;
+    return state;
+}
+
+/**
+ * @brief AppsListModel::currentRows 获取 AppsManager 列表中当前页的各行
+ */
+QVector<AppsListModel::RowState> AppsListModel::currentRows() const
+{
+    const int count = pageRowCount();
+
+    QVector<RowState> rows;
+    rows.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const ItemInfo_v1 *info = itemInfoAt(itemRow(createIndex(i, 0)));
+        rows.append(info ? rowState(*info) : RowState());
+    }
+
+    return rows;
+}
+
+/**
+ * @brief AppsListModel::updateRows 列表变化后与视图当前的各行比较, 只通知发生变化的行,
+ * 避免整体刷新时视图重新获取所有行的数据并重绘
+ */
+void AppsListModel::updateRows()
+{
+    // 视图处理行变化的过程中列表再次变化时, 本次完成后重新比较
+    if (m_updatingRows) {
+        m_rowsOutdated = true;
+        return;
+    }
+
+    do {
+        m_rowsOutdated = false;
+
+        const QVector<RowState> rows = currentRows();
+        m_updatingRows = true;
+        applyRows(rows);
+        m_updatingRows = false;
+    } while (m_rowsOutdated);
+}
+
+/**
+ * @brief AppsListModel::applyRows 依次通知视图删除、移动、插入的行, 以及内容变化的行
+ * @param rows 列表中当前页的各行
+ */
+void AppsListModel::applyRows(const QVector<RowState> &rows)
+{
+    // 删除新的各行中不存在的行, 同一 id 出现多次时按出现的次数保留
+    QHash<QString, int> remaining;
+    for (const RowState &row : rows)
+        ++remaining[row.id];
+
+    QVector<bool> keep(m_rows.size());
+    for (int i = 0; i < m_rows.size(); ++i) {
+        auto it = remaining.find(m_rows.at(i).id);
+        keep[i] = it != remaining.end() && it.value()-- > 0;
+    }
+
+    for (int last = m_rows.size() - 1; last >= 0; --last) {
+        if (keep.at(last))
+            continue;
+
+        int first = last;
+        while (first > 0 && !keep.at(first - 1))
+            --first;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.remove(first, last - first + 1);
+        endRemoveRows();
+
+        last = first;
+    }
+
+    // 同一 id 的前几次出现对应保留的行, 超出保留数量的出现才是新增的行
+    QHash<QString, int> existing;
+    for (const RowState &row : m_rows)
+        ++existing[row.id];
+
+    QVector<bool> added(rows.size());
+    for (int i = 0; i < rows.size(); ++i) {
+        auto it = existing.find(rows.at(i).id);
+        added[i] = it == existing.end() || it.value()-- <= 0;
+    }
+
+    // 按新的顺序移动已有的行, 连续新增的行作为一个范围插入, 避免代理模型逐行重新筛选
+    int movedCount = 0;
+    for (int i = 0; i < rows.size(); ++i) {
+        if (added.at(i)) {
+            int last = i;
+            while (last + 1 < rows.size() && added.at(last + 1))
+                ++last;
+
+            beginInsertRows(QModelIndex(), i, last);
+            m_rows = m_rows.mid(0, i) + rows.mid(i, last - i + 1) + m_rows.mid(i);
+            endInsertRows();
+
+            i = last;
+            continue;
+        }
+
+        if (i < m_rows.size() && m_rows.at(i).id == rows.at(i).id)
+            continue;
+
+        int from = -1;
+        for (int j = i + 1; j < m_rows.size(); ++j) {
+            if (m_rows.at(j).id == rows.at(i).id) {
+                from = j;
+                break;
+            }
+        }
+
+        if (++movedCount > MAX_MOVED_ROWS) {
+            emit QAbstractItemModel::layoutAboutToBeChanged();
+            m_rows = rows;
+            emit QAbstractItemModel::layoutChanged();
+            return;
+        }
+
+        beginMoveRows(QModelIndex(), from, from, QModelIndex(), i);
+        m_rows.move(from, i);
+        endMoveRows();
+    }
+
+    // 只重绘内容变化的行, 仅安装状态或进度变化时只通知对应的数据
+    for (int i = 0; i < rows.size(); ++i) {
+        const RowState &oldRow = m_rows.at(i);
+        const RowState &newRow = rows.at(i);
+        const QModelIndex modelIndex = index(i);
+
+        if (oldRow.contentHash != newRow.contentHash) {
+            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
+        } else if (oldRow.status != newRow.status || oldRow.progressValue != newRow.progressValue) {
+            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex, { AppItemStatusRole, AppRowSnapshotRole });
+        }
+    }
+
+    m_rows = rows;
+}
+
 /**
  * @brief AppsListModel::indexDragging 区分无效拖动和有效拖动
  * @param index 拖动的item对应的模型索引
@@ -666,14 +953,40 @@ bool AppsListModel::indexDragging(const QModelIndex &index) const
  */
 void AppsListModel::itemDataChanged(const ItemInfo_v1 &info)
 {
-    int i = 0;
+    // 直接引用 AppsManager 中的应用信息, 每个图标加载完成时都会调用, 不复制每一行
     const int count = rowCount(QModelIndex());
-    while (i != count) {
-        if (index(i).data(AppKeyRole).toString() == info.m_key) {
-            const QModelIndex modelIndex = index(i);
-            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex);
+    for (int i = 0; i < count; ++i) {
+        const QModelIndex modelIndex = index(i);
+        const ItemInfo_v1 *itemInfoPtr = itemInfoAt(itemRow(modelIndex));
+        if (!itemInfoPtr)
+            continue;
+
+        const ItemInfo_v1 &itemInfo = *itemInfoPtr;
+
+        // 应用文件夹中的应用变化时, 刷新文件夹
+        bool isInDir = false;
+        for (const ItemInfo_v1 &dirItemInfo : itemInfo.m_appInfoList) {
+            if (dirItemInfo.m_desktop == info.m_desktop) {
+                isInDir = true;
+                break;
+            }
+        }
+
+        if (itemInfo.m_desktop == info.m_desktop || isInDir) {
+            // 安装过程中只有状态或进度变化, 只通知对应的数据
+            QVector<int> roles;
+            if (i < m_rows.size() && m_rows.at(i).id == itemInfo.m_desktop) {
+                const RowState state = rowState(itemInfo);
+                const RowState &oldState = m_rows.at(i);
+                if (state.contentHash == oldState.contentHash
+                        && (state.status != oldState.status || state.progressValue != oldState.progressValue))
+                    roles = { AppItemStatusRole, AppRowSnapshotRole };
+
+                m_rows[i] = state;
+            }
+
+            emit QAbstractItemModel::dataChanged(modelIndex, modelIndex, roles);
             return;
         }
-        ++i;
     }
 }
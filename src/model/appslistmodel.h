@@ -6,6 +6,8 @@
 #define APPSLISTMODEL_H
 
 #include <QAbstractListModel>
+#include <QPixmap>
+#include <QVector>
 #define MAXIMUM_POPULAR_ITEMS 11
 
 class AppsManager;
@@ -61,6 +63,7 @@ public:
         AppCanSendToDockRole,
         AppCanStartUpRole,
         AppCanOpenProxyRole,
+        AppRowSnapshotRole,
     };
 
     enum AppCategory {
@@ -87,9 +90,42 @@ public:
         Others,
     };
 
+    /**绘制一个 item 所需的全部数据, 代理每次绘制只需获取一次
+     * @brief The RowSnapshot struct
+     */
+    struct RowSnapshot
+    {
+        QString displayName;        // 应用名称, 玲珑应用按配置带有后缀
+        QString description;
+        QPixmap icon;
+        QSize iconSize;
+        int fontPixelSize = 0;
+        int status = 0;
+        int progressValue = 0;
+        int dirItemCount = 0;
+        bool isDir = false;
+        bool isTitle = false;
+        bool isNewInstall = false;
+        bool isAutoStart = false;
+        bool isDragging = false;
+        bool drawBackground = false;
+    };
+
+private:
+    /**视图当前所见的一行, 列表变化后与新的各行比较, 只通知插入、删除、移动及内容变化的行
+     * @brief The RowState struct
+     */
+    struct RowState
+    {
+        QString id;                 // 应用的desktop全路径, 无效的行为空
+        uint contentHash = 0;       // 名称、图标、描述等除安装状态外的显示内容
+        int status = 0;
+        int progressValue = 0;
+    };
+
 public:
     explicit AppsListModel(const AppCategory& category, QObject *parent = nullptr);
-    void setPageIndex(int pageIndex) { m_pageIndex = pageIndex; }
+    void setPageIndex(int pageIndex);
     int getPageIndex() const { return m_pageIndex; }
 
     inline AppCategory category() const {return m_category;}
@@ -123,7 +159,18 @@ private:
     void dataChanged(const AppsListModel::AppCategory category);
     void layoutChanged(const AppsListModel::AppCategory category);
     bool indexDragging(const QModelIndex &index) const;
+    int itemRow(const QModelIndex &index) const;
+    const ItemInfo_v1 *itemInfoAt(const int row) const;
+    const RowSnapshot rowSnapshot(const QModelIndex &index, const ItemInfo_v1 &itemInfo) const;
     void itemDataChanged(const ItemInfo_v1 &info);
+    void itemRowsChanged(const AppsListModel::AppCategory category);
+    bool isPaged() const;
+    bool showsList(const AppsListModel::AppCategory category) const;
+    int pageRowCount() const;
+    RowState rowState(const ItemInfo_v1 &info) const;
+    QVector<RowState> currentRows() const;
+    void updateRows();
+    void applyRows(const QVector<RowState> &rows);
 
 private:
     AppsManager *m_appsManager;
@@ -151,9 +198,14 @@ private:
 
     bool m_drawBackground;
     int m_pageIndex;
+
+    QVector<RowState> m_rows;       // 最近一次通知视图后的各行
+    bool m_updatingRows;            // 正在通知视图, 行数以 m_rows 为准
+    bool m_rowsOutdated;            // 通知视图的过程中列表再次变化
 };
 typedef QList<AppsListModel *> PageAppsModelist;
 
 Q_DECLARE_METATYPE(AppsListModel::AppCategory)
+Q_DECLARE_METATYPE(AppsListModel::RowSnapshot)
 
 #endif // APPSLISTMODEL_H
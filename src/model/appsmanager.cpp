@@ -6,6 +6,11 @@
 #include "util.h"
 #include "constants.h"
 #include "calculate_util.h"
+#include "iconcachemanager.h"
+#include "iconatlas.h"
+#include "iconrenderworker.h"
+#include "appsearchindex.h"
+#include "dbusproxyregistry.h"
 
 #include <QDebug>
 #include <QX11Info>
@@ -20,6 +25,7 @@
 #include <QStandardPaths>
 #include <QByteArrayList>
 #include <QQueue>
+#include <QVector>
 
 #include <DHiDPIHelper>
 #include <DApplication>
@@ -41,44 +47,58 @@ const QString TRASH_DIR = QDir::homePath() + "/.local/share/Trash";
 const QString TRASH_PATH = TRASH_DIR + "/files";
 const QDir::Filters NAME_FILTERS = QDir::AllEntries | QDir::Hidden | QDir::System | QDir::NoDotAndDotDot;
 
-bool AppsManager::readJsonFile(QIODevice &device, QSettings::SettingsMap &map)
+/**
+ * @brief desktopIndex 查找列表中应用所在的行, 不查找文件夹内的应用
+ * @return 行号, 不存在时返回 -1
+ */
+static int desktopIndex(const ItemInfoList_v1 &list, const QString &desktop)
 {
-    QJsonParseError jsonParser;
-    map = QJsonDocument::fromJson(device.readAll(), &jsonParser).toVariant().toMap();
-
-    return jsonParser.error == QJsonParseError::NoError;
-}
+    for (int i = 0; i < list.size(); ++i) {
+        if (!list.at(i).m_isDir && list.at(i).m_desktop == desktop)
+            return i;
+    }
 
-bool AppsManager::writeJsonFile(QIODevice &device, const QSettings::SettingsMap &map)
-{
-    QJsonDocument jsonDocument = QJsonDocument::fromVariant(QVariant::fromValue(map));
-    return device.write(jsonDocument.toJson()) != -1;
+    return -1;
 }
 
-void AppsManager::registerSettingsFormat()
-{
-    const QSettings::Format JsonFormat = QSettings::registerFormat("json", readJsonFile, writeJsonFile);
-    m_collectedSetting = new QSettings(JsonFormat, QSettings::UserScope, "deepin","dde-launcher-app-collect-list", this);
-    m_categorySetting = new QSettings(JsonFormat, QSettings::UserScope, "deepin","dde-launcher-app-category-used-sorted-list", this);
-    m_fullscreenUsedSortSetting = new QSettings(JsonFormat, QSettings::UserScope, "deepin","dde-launcher-fullscreen-app-used-sorted-list", this);
-    m_windowedUsedSortSetting = new QSettings(JsonFormat, QSettings::UserScope, "deepin", "dde-launcher-windowed-app-used-sorted-list", this);
+/**
+ * @brief replaceAppInfo 更新列表及文件夹中 desktop 相同的应用信息, 保持列表中记录的打开次数
+ */
+static void replaceAppInfo(ItemInfoList_v1 &list, const ItemInfo_v1 &info)
+{
+    for (ItemInfo_v1 &item : list) {
+        if (item.m_isDir) {
+            replaceAppInfo(item.m_appInfoList, info);
+        } else if (item.m_desktop == info.m_desktop) {
+            const qlonglong openCount = item.m_openCount;
+            const qlonglong firstRunTime = item.m_firstRunTime;
+            item = info;
+            item.m_openCount = qMax(openCount, info.m_openCount);
+            if (item.m_firstRunTime == 0)
+                item.m_firstRunTime = firstRunTime;
+        }
+    }
 }
 
 AppsManager::AppsManager(QObject *parent)
     : QObject(parent)
     , m_startManagerInter(new DBusStartManager(this))
-    , m_amDbusLauncherInter(new AMDBusLauncherInter(this))
-    , m_amDbusDockInter(new AMDBusDockInter(this))
+    , m_amDbusLauncherInter(DBusProxyRegistry::instance()->proxy<AMDBusLauncherInter>())
+    , m_amDbusDockInter(DBusProxyRegistry::instance()->proxy<AMDBusDockInter>())
+    , m_appStatusTable(new AppStatusTable(m_amDbusLauncherInter, m_amDbusDockInter, this))
+    , m_appRegistry(m_allAppInfoList)
     , m_calUtil(CalculateUtil::instance())
-    , m_delayRefreshTimer(new QTimer(this))
     , m_refreshCalendarIconTimer(new QTimer(this))
     , m_lastShowDate(0)
-    , m_tryNums(0)
-    , m_tryCount(0)
-    , m_itemInfo(ItemInfo_v1())
+    , m_collectedStore(new SortedListStore("dde-launcher-app-collect-list", this))
+    , m_categoryStore(new SortedListStore("dde-launcher-app-category-used-sorted-list", this))
+    , m_fullscreenUsedSortStore(new SortedListStore("dde-launcher-fullscreen-app-used-sorted-list", this))
+    , m_windowedUsedSortStore(new SortedListStore("dde-launcher-windowed-app-used-sorted-list", this))
     , m_autostartDesktopListSetting(new QSettings("deepin", AUTOSTART_KEY, this))
+    , m_saveAutostartTimer(new QTimer(this))
+    , m_autostartListLoading(false)
+    , m_refreshGroupListsTimer(new QTimer(this))
     , m_filterSetting(nullptr)
-    , m_iconValid(true)
     , m_trashIsEmpty(false)
     , m_fsWatcher(new QFileSystemWatcher(this))
     , m_updateCalendarTimer(new QTimer(this))
@@ -98,9 +118,6 @@ AppsManager::AppsManager(QObject *parent)
 
     qDebug() << "m_amDbusLauncherInter is valid:" << m_amDbusLauncherInter->isValid();
 
-    // QSettings 添加Json格式支持
-    registerSettingsFormat();
-
     // 分类目录名称
     m_categoryTs.append(tr("Internet"));
     m_categoryTs.append(tr("Chat"));
@@ -118,10 +135,15 @@ AppsManager::AppsManager(QObject *parent)
     m_updateCalendarTimer->start();
 
     updateTrashState();
+    migrateLegacySortedLists();
     refreshAllList();
+    loadAutostartCache();
 
-    m_delayRefreshTimer->setSingleShot(true);
-    m_delayRefreshTimer->setInterval(500);
+    m_saveAutostartTimer->setSingleShot(true);
+    m_saveAutostartTimer->setInterval(DLauncher::AUTOSTART_SAVE_DELAY_TIME);
+
+    m_refreshGroupListsTimer->setSingleShot(true);
+    m_refreshGroupListsTimer->setInterval(DLauncher::GROUP_LIST_REFRESH_DELAY_TIME);
 
     m_refreshCalendarIconTimer->setInterval(1000);
     m_refreshCalendarIconTimer->setSingleShot(false);
@@ -136,8 +158,17 @@ AppsManager::AppsManager(QObject *parent)
 
     // TODO：自启动/打开应用这个接口后期sprint2时再改，目前 AM 未做处理
     connect(m_startManagerInter, &DBusStartManager::AutostartChanged, this, &AppsManager::refreshAppAutoStartCache);
+    connect(m_saveAutostartTimer, &QTimer::timeout, this, &AppsManager::saveAutostartCache);
+    connect(m_refreshGroupListsTimer, &QTimer::timeout, this, &AppsManager::refreshGroupLists);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, [ this ] {
+        // 退出前写入尚未保存的修改
+        if (m_saveAutostartTimer->isActive()) {
+            m_saveAutostartTimer->stop();
+            saveAutostartCache();
+        }
+    });
 
-    connect(m_delayRefreshTimer, &QTimer::timeout, this, &AppsManager::delayRefreshData);
+    connect(IconRenderWorker::instance(), &IconRenderWorker::iconRendered, this, &AppsManager::onIconRendered);
     connect(m_fsWatcher, &QFileSystemWatcher::directoryChanged, this, &AppsManager::updateTrashState, Qt::QueuedConnection);
     connect(m_refreshCalendarIconTimer, &QTimer::timeout, this, &AppsManager::onRefreshCalendarTimer);
 
@@ -145,91 +176,118 @@ AppsManager::AppsManager(QObject *parent)
         m_refreshCalendarIconTimer->start();
 }
 
-void AppsManager::showSearchedData(const AppInfoList &list)
+/**
+ * @brief AppsManager::appendSearchedData 合并单个插件返回的搜索结果, 已存在的应用不重复添加
+ * @param list 插件搜索结果
+ */
+void AppsManager::appendSearchedData(const AppInfoList &list)
+{
+    bool changed = false;
+    for (const AppInfo &appInfo : list) {
+        const ItemInfo_v1 info(appInfo);
+        auto it = std::find_if(m_appSearchResultList.constBegin(), m_appSearchResultList.constEnd(), [ & ](const ItemInfo_v1 &item) {
+            return item.m_desktop == info.m_desktop;
+        });
+
+        if (it != m_appSearchResultList.constEnd())
+            continue;
+
+        m_appSearchResultList.append(info);
+        changed = true;
+    }
+
+    if (changed)
+        emit dataChanged(AppsListModel::PluginSearch);
+}
+
+/**
+ * @brief AppsManager::clearSearchedData 搜索内容变化后清空插件搜索结果
+ */
+void AppsManager::clearSearchedData()
 {
-    m_appSearchResultList = ItemInfo_v1::appListToItemV1List(list);
+    if (m_appSearchResultList.isEmpty())
+        return;
+
+    m_appSearchResultList.clear();
+    emit dataChanged(AppsListModel::PluginSearch);
 }
 
+/**
+ * @brief AppsManager::sortByLetterOrder 按照首字母对应用分组, 每组前插入字母标题
+ * 每个应用只计算一次排序键(去掉声调的拼音及所属分组), 稳定排序后一次遍历生成分组
+ * @param list 按名称排序后的应用列表, 同组内排序键相同的应用保持原有顺序
+ * @return 带有字母标题的分组列表, 数字开头的应用位于 # 分组
+ */
 ItemInfoList_v1 AppsManager::sortByLetterOrder(ItemInfoList_v1 &list)
 {
-    // 字母标题生成器
-    static QList<QChar> alphabetList;
-    if (alphabetList.isEmpty()) {
-        alphabetList.append('#');
-        for (int i = 0; i < 26; i++)
-            alphabetList.append(QChar('A' + i));
-    }
+    struct LetterSortKey {
+        int group;              // 0 为 #, 1 ~ 26 为 A ~ Z
+        bool startWithLetter;   // 同组内字母开头的应用排在中文等其他应用之前
+        QString pinyin;
+        int index;
+    };
 
-    ItemInfoList_v1 letterGroupList;
-    // 按照字母表顺序对应用进行分组排序
-    for (int i = 0; i < alphabetList.size(); i++) {
-        const QChar &titleChar = alphabetList[i];
-        ItemInfo_v1 titleInfo;
-        titleInfo.m_name = titleChar;
-        titleInfo.m_desktop = titleChar;
-
-        ItemInfoList_v1 groupList;
-        for (int j = 0; j < list.size(); j++) {
-            const ItemInfo_v1 &info = list.at(j);
-            // 去掉字符串中的数字(表示拼音中的声调)
-            const QString pinYinStr = Chinese2Pinyin(info.m_name).remove(QRegExp("\\d"));
-            if (info.startWithNum()) {
-                if (!contains(groupList, titleInfo) && (!contains(letterGroupList, titleInfo)))
-                    groupList.append(titleInfo);
-
-                if (!contains(letterGroupList, info))
-                    groupList.append(info);
-            } else if (pinYinStr.startsWith(titleChar, Qt::CaseInsensitive)) {
-                if (!contains(groupList, titleInfo))
-                    groupList.append(titleInfo);
-
-                if (!contains(letterGroupList, info))
-                    groupList.append(info);
-            }
+    QVector<LetterSortKey> keys;
+    keys.reserve(list.size());
+    for (int i = 0; i < list.size(); i++) {
+        const ItemInfo_v1 &info = list.at(i);
 
-            if (j == list.size() - 1) {
-                // 数字不变, 在首字母相同的且都为中文的分组中比较全拼音，按升序排列
-                sortByPinyinOrder(groupList);
-            }
+        // 去掉字符串中的数字(表示拼音中的声调)
+        const QString pinyinWithTone = Chinese2Pinyin(info.m_name);
+        QString pinyin;
+        pinyin.reserve(pinyinWithTone.size());
+        for (const QChar &ch : pinyinWithTone) {
+            if (!ch.isDigit())
+                pinyin.append(ch);
         }
 
-        // 该字母分类下没有应用时，不加入到列表
-        if (groupList.size() > 1)
-            letterGroupList.append(groupList);
+        int group = -1;
+        const ushort firstChar = pinyin.isEmpty() ? 0 : pinyin.at(0).toUpper().unicode();
+        if (info.startWithNum() || firstChar == '#')
+            group = 0;
+        else if (firstChar >= 'A' && firstChar <= 'Z')
+            group = firstChar - 'A' + 1;
+
+        // 不以数字或字母开头的应用不加入分组
+        if (group != -1)
+            keys.append({ group, info.startWithLetter(), pinyin, i });
     }
 
-    return letterGroupList;
-}
+    std::stable_sort(keys.begin(), keys.end(), [](const LetterSortKey &key1, const LetterSortKey &key2) {
+        if (key1.group != key2.group)
+            return key1.group < key2.group;
 
-void AppsManager::sortByPinyinOrder(ItemInfoList_v1 &processList)
-{
-    std::sort(processList.begin(), processList.end(), [ & ](ItemInfo_v1 &info1, ItemInfo_v1 &info2) {
-        QString appPinyinName1 = Chinese2Pinyin(info1.m_name).remove(QRegExp("\\d"));
-        QString appPinyinName2 = Chinese2Pinyin(info2.m_name).remove(QRegExp("\\d"));
+        if (key1.startWithLetter != key2.startWithLetter)
+            return key1.startWithLetter;
 
-        // 1. 若是标题则不执行交换位置;二者中只有一个以字母或者数字开头，保持从小到大的顺序, 维持通用排序的顺序不变
-        // 2. 二者中的其他情况则进行比对, 如果不是从小到大顺序排列，则交换位置
+        return key1.pinyin.compare(key2.pinyin, Qt::CaseSensitive) < 0;
+    });
 
-        if (info1.isTitle() || info2.isTitle()
-                || (info1.startWithLetter() && !info2.startWithLetter())
-                || (!info1.startWithLetter() && info2.startWithLetter()))
-            return false;
+    ItemInfoList_v1 letterGroupList;
+    letterGroupList.reserve(keys.size() + 27);
+
+    int currentGroup = -1;
+    for (const LetterSortKey &key : keys) {
+        if (key.group != currentGroup) {
+            currentGroup = key.group;
+
+            const QChar titleChar = currentGroup == 0 ? QChar('#') : QChar('A' + currentGroup - 1);
+            ItemInfo_v1 titleInfo;
+            titleInfo.m_name = titleChar;
+            titleInfo.m_desktop = titleChar;
+            letterGroupList.append(titleInfo);
+        }
 
-        return (appPinyinName1.compare(appPinyinName2, Qt::CaseSensitive) < 0);
-    });
+        letterGroupList.append(list.at(key.index));
+    }
+
+    return letterGroupList;
 }
 
 const ItemInfo_v1 AppsManager::getItemInfo(const QString &desktop)
 {
-    ItemInfo_v1 itemInfo;
-    for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            itemInfo = info;
-            break;
-        }
-    }
-
-    return itemInfo;
+    const int index = m_appRegistry.indexOf(desktop);
+    return index != -1 ? m_allAppInfoList.at(index) : ItemInfo_v1();
 }
 
 void AppsManager::dropToCollected(const ItemInfo_v1 &info, const int row)
@@ -243,82 +301,6 @@ void AppsManager::dropToCollected(const ItemInfo_v1 &info, const int row)
     emit dataChanged(AppsListModel::Favorite);
 }
 
-QSettings::SettingsMap AppsManager::getCacheMapData(const ItemInfoList_v1 &list)
-{
-    auto fillMapData = [ & ](QSettings::SettingsMap &map, const ItemInfo_v1 &info) {
-        map.insert("desktop", info.m_desktop);
-        map.insert("appName", info.m_name);
-        map.insert("appKey", info.m_key);
-        map.insert("iconKey", info.m_iconKey);
-        map.insert("appStatus", info.m_status);
-        map.insert("categoryId", info.m_categoryId);
-        map.insert("description", info.m_description);
-        map.insert("progressValue", info.m_progressValue);
-        map.insert("installTime", info.m_installedTime);
-        map.insert("openCount", info.m_openCount);
-        map.insert("firstRunTime", info.m_firstRunTime);
-        map.insert("isDir", info.m_isDir);
-    };
-
-    QSettings::SettingsMap map;
-    for (int i = 0; i < list.size(); i++) {
-        QSettings::SettingsMap itemMap, itemDirMap;
-        const ItemInfo_v1 &info = list.at(i);
-        fillMapData(itemMap, info);
-
-        for (int j = 0; j < info.m_appInfoList.size(); j++) {
-            const ItemInfo_v1 &dirInfo = info.m_appInfoList.at(j);
-            fillMapData(itemDirMap, dirInfo);
-            itemMap.insert(QString("appInfoList_%1").arg(j), itemDirMap);
-        }
-        if (info.m_isDir)
-            itemMap.insert("appInfoSize", info.m_appInfoList.size());
-
-        map.insert(QString("itemInfoList_%1").arg(i), itemMap);
-    }
-
-    return map;
-}
-
-const ItemInfoList_v1 AppsManager::readCacheData(const QSettings::SettingsMap &map)
-{
-    auto getMapData = [ & ](ItemInfo_v1 &info, const QMap<QString, QVariant> &infoMap) {
-        info.m_desktop = infoMap.value("desktop").toString();
-        info.m_name = infoMap.value("appName").toString();
-        info.m_key = infoMap.value("appKey").toString();
-        info.m_iconKey = infoMap.value("iconKey").toString();
-        info.m_status = infoMap.value("appStatus").toInt();
-        info.m_categoryId = infoMap.value("categoryId").toLongLong();
-        info.m_description = infoMap.value("description").toString();
-        info.m_progressValue = infoMap.value("progressValue").toInt();
-        info.m_installedTime = infoMap.value("installTime").toInt();
-        info.m_openCount = infoMap.value("openCount").toLongLong();
-        info.m_firstRunTime = infoMap.value("firstRunTime").toLongLong();
-        info.m_isDir = infoMap.value("isDir").toLongLong();
-    };
-
-    ItemInfoList_v1 infoList;
-    for (int i = 0; i < map.size(); i++) {
-        ItemInfo_v1 info;
-        ItemInfoList_v1 appList;
-        QMap<QString, QVariant> itemInfoMap = map.value(QString("itemInfoList_%1").arg(i)).toMap();
-
-        getMapData(info, itemInfoMap);
-        int appInfoSize = itemInfoMap.contains("appInfoSize") ? itemInfoMap.value("appInfoSize").toInt() : 0;
-
-        ItemInfo_v1 appInfo;
-        for (int j = 0; j < appInfoSize; j++) {
-            QMap<QString, QVariant> appInfoMap = itemInfoMap.value(QString("appInfoList_%1").arg(j)).toMap();
-            getMapData(appInfo, appInfoMap);
-            appList.append(appInfo);
-        }
-        info.m_appInfoList.append(appList);
-        infoList.append(info);
-    }
-
-    return infoList;
-}
-
 /**保存当前拖拽的类型
  * @brief AppsManager::setDragMode
  * @param mode 拖拽类型
@@ -463,19 +445,11 @@ void AppsManager::loadDefaultFavoriteList(const ItemInfoList_v1 &processList)
     m_favoriteSortedList.clear();
 
     auto defaultFavoriteList = [ & ](const ItemInfoList_v1 &list, const QStringList &strAppKeyList) {
+        const AppRegistry registry(list);
         for (const QString &appKey : strAppKeyList) {
-            for (const ItemInfo_v1 &info : list) {
-                // 优先显示玲珑应用
-                if (info.m_key == appKey && info.isLingLongApp()) {
-                    m_favoriteSortedList.append(info);
-                    break;
-                }
-
-                if (info.m_key == appKey && !info.isLingLongApp()) {
-                    m_favoriteSortedList.append(info);
-                    break;
-                }
-            }
+            const int index = registry.indexOfKey(appKey);
+            if (index != -1)
+                m_favoriteSortedList.append(list.at(index));
         }
     };
 
@@ -528,17 +502,14 @@ void AppsManager::removeNonexistentData()
     QHash<AppsListModel::AppCategory, ItemInfoList_v1>::iterator categoryAppsIter = m_appInfos.begin();
     for (; categoryAppsIter != m_appInfos.end(); ++categoryAppsIter) {
         ItemInfoList_v1 &item = categoryAppsIter.value();
+
+        // 多语言时，更新应用信息
+        hydrateSortedList(item);
         for (auto it(item.begin()); it != item.end();) {
-            if (!contains(m_allAppInfoList, *it)) {
+            if (!m_appRegistry.contains(*it))
                 it = item.erase(it);
-            } else {
-                // 多语言时，更新应用信息
-                int index = itemIndex(m_allAppInfoList, *it);
-                if (index != -1)
-                    it->updateInfo(m_allAppInfoList[index]);
-
+            else
                 ++it;
-            }
         }
     }
 
@@ -547,25 +518,13 @@ void AppsManager::removeNonexistentData()
     for (ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
         if (info.m_isDir) {
             // 从文件夹中移除不存在的应用
-            for (ItemInfo_v1 &dirItem : info.m_appInfoList) {
-                if (!contains(m_allAppInfoList, dirItem)) {
+            for (const ItemInfo_v1 &dirItem : info.m_appInfoList) {
+                if (!m_appRegistry.contains(dirItem))
                     appListToRemove.append(dirItem);
-                } else {
-                    // 多语言时，更新应用信息
-                    int index = itemIndex(m_allAppInfoList, dirItem);
-                    if (index != -1)
-                        dirItem.updateInfo(m_allAppInfoList[index]);
-                }
             }
         } else {
-            if (!contains(m_allAppInfoList, info)) {
+            if (!m_appRegistry.contains(info))
                 appListToRemove.append(info);
-            } else {
-                // 多语言时，更新应用信息
-                int index = itemIndex(m_allAppInfoList, info);
-                if (index != -1)
-                    info.updateInfo(m_allAppInfoList[index]);
-            }
         }
     }
 
@@ -597,7 +556,7 @@ void AppsManager::removeNonexistentData()
     auto removeItems = [ & ](ItemInfoList_v1 &list) {
         ItemInfoList_v1 listToRemove;
         for (const ItemInfo_v1 &info : list) {
-            if (!contains(m_allAppInfoList, info))
+            if (!m_appRegistry.contains(info))
                 listToRemove.append(info);
         }
 
@@ -606,6 +565,7 @@ void AppsManager::removeNonexistentData()
     };
 
     // 移除 m_favoriteSortedList 收藏应用中不存在的应用
+    hydrateSortedList(m_favoriteSortedList);
     removeItems(m_favoriteSortedList);
 
     // 移除 m_windowedUsedSortedList 中不存在的应用
@@ -889,13 +849,9 @@ void AppsManager::insertDropItem(int pos)
  */
 void AppsManager::abandonStashedItem(const QString &desktop)
 {
-    // 遍历应用列表,存在则从列表中移除
-    for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            APP_AUTOSTART_CACHE.remove(info.m_desktop);
-            break;
-        }
-    }
+    // 应用存在则从自启动缓存中移除
+    if (m_appRegistry.indexOf(desktop) != -1 && APP_AUTOSTART_CACHE.remove(desktop))
+        scheduleSaveAutostartCache();
 
     //重新获取分类数据，类似wps一个appkey对应多个desktop文件的时候,有可能会导致漏掉
     refreshCategoryInfoList();
@@ -965,17 +921,17 @@ void AppsManager::refreshAllList()
 
 void AppsManager::saveWidowedUsedSortedList()
 {
-    m_windowedUsedSortSetting->setValue("lists", getCacheMapData(m_windowedUsedSortedList));
+    m_windowedUsedSortStore->setValue("lists", m_windowedUsedSortedList);
 }
 
 void AppsManager::saveFullscreenUsedSortedList()
 {
-    m_fullscreenUsedSortSetting->setValue("lists", getCacheMapData(m_fullscreenUsedSortedList));
+    m_fullscreenUsedSortStore->setValue("lists", m_fullscreenUsedSortedList);
 }
 
 void AppsManager::saveCollectedSortedList()
 {
-    m_collectedSetting->setValue("lists", getCacheMapData(m_favoriteSortedList));
+    m_collectedStore->setValue("lists", m_favoriteSortedList);
 }
 
 void AppsManager::searchApp(const QString &keywords)
@@ -1002,14 +958,14 @@ void AppsManager::launchApp(const QModelIndex &index)
     m_startManagerInter->Launch(desktop);
 
     // 更新应用的打开次数以及首次启动的时间戳
-    for (ItemInfo_v1 &info: m_allAppInfoList) {
-        if (info.m_desktop == desktop) {
-            ++info.m_openCount;
-            if (info.m_firstRunTime == 0)
-                info.m_firstRunTime = QDateTime::currentMSecsSinceEpoch() / 1000;
-
-            break;
-        }
+    const int index = m_appRegistry.indexOf(desktop);
+    if (index != -1) {
+        ItemInfo_v1 &info = m_allAppInfoList[index];
+        ++info.m_openCount;
+        if (info.m_firstRunTime == 0)
+            info.m_firstRunTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+
+        AppSearchIndex::instance()->updateUsage(info);
     }
 
     refreshItemInfoList();
@@ -1092,15 +1048,6 @@ void AppsManager::delayRefreshData()
     emit dataChanged(AppsListModel::FullscreenAll);
 }
 
-/**
- * @brief AppsManager::refreshIcon 刷新当前安装/卸载/更新的应用图标
- */
-void AppsManager::refreshIcon()
-{
-    // 更新单个应用信息
-    appIcon(m_itemInfo);
-}
-
 bool AppsManager::fuzzyMatching(const QStringList& list, const QString& key)
 {
     for (const QString& l : list) {
@@ -1116,6 +1063,12 @@ void AppsManager::onRefreshCalendarTimer()
     m_curDate = QDate::currentDate();
 
     if(m_lastShowDate != m_curDate.day()) {
+        // 日历图标随日期变化, 移除缓存的旧图标
+        for (const ItemInfo_v1 &info : m_allAppInfoList) {
+            if (info.m_desktop.contains("/dde-calendar.desktop"))
+                IconCacheManager::instance()->removeItem(info.m_desktop);
+        }
+
         delayRefreshData();
         m_lastShowDate = m_curDate.day();
     }
@@ -1226,58 +1179,51 @@ int AppsManager::appsInfoListSize(const AppsListModel::AppCategory &category)
     return m_appInfos[category].size();
 }
 
-const ItemInfo_v1 AppsManager::appsInfoListIndex(const AppsListModel::AppCategory &category, const int index)
+/**
+ * @brief AppsManager::appsInfoListItem 获取分类列表中的应用信息, 不复制数据
+ * @param category 列表的分类
+ * @param index 应用在列表中的位置
+ * @return 应用信息, 位置无效时返回 nullptr, 列表变化后不能再使用
+ */
+const ItemInfo_v1 *AppsManager::appsInfoListItem(const AppsListModel::AppCategory &category, const int index) const
 {
+    const ItemInfoList_v1 *list = nullptr;
+
     switch (category) {
     case AppsListModel::TitleMode:
-        Q_ASSERT(m_appCategoryInfos.size() > index);
-        return m_appCategoryInfos[index];
+        list = &m_appCategoryInfos;
+        break;
     case AppsListModel::LetterMode:
-        Q_ASSERT(m_appLetterModeInfos.size() > index);
-        return m_appLetterModeInfos[index];
+        list = &m_appLetterModeInfos;
+        break;
     case AppsListModel::Favorite:
-        Q_ASSERT(m_favoriteSortedList.size() > index);
-        return m_favoriteSortedList[index];
+        list = &m_favoriteSortedList;
+        break;
     case AppsListModel::WindowedAll:
-        Q_ASSERT(m_windowedUsedSortedList.size() > index);
-        return m_windowedUsedSortedList[index];
     case AppsListModel::Search:
-        Q_ASSERT(m_windowedUsedSortedList.size() > index);
-        return m_windowedUsedSortedList[index];
+        list = &m_windowedUsedSortedList;
+        break;
     case AppsListModel::FullscreenAll:
-        Q_ASSERT(m_fullscreenUsedSortedList.size() > index);
-        return m_fullscreenUsedSortedList[index];
+        list = &m_fullscreenUsedSortedList;
+        break;
     case AppsListModel::PluginSearch:
-        Q_ASSERT(m_appSearchResultList.size() > index);
-        return m_appSearchResultList[index];
+        list = &m_appSearchResultList;
+        break;
     case AppsListModel::Dir:
-        return m_dirAppInfoList[index];
-    default:
+        list = &m_dirAppInfoList;
+        break;
+    default: {
+        auto it = m_appInfos.constFind(category);
+        if (it != m_appInfos.constEnd())
+            list = &it.value();
         break;
     }
+    }
 
-    ItemInfo_v1 itemInfo;
-
-    Q_ASSERT(m_appInfos[category].size() > index);
-    itemInfo = m_appInfos[category][index];
-
-    return itemInfo;
-}
-
-const ItemInfo_v1 AppsManager::appsCategoryListIndex(const int index)
-{
-    if (index > m_appCategoryInfos.size() - 1)
-        return ItemInfo_v1();
-
-    return m_appCategoryInfos.at(index);
-}
-
-const ItemInfo_v1 AppsManager::appsLetterListIndex(const int index)
-{
-    if (index > m_appLetterModeInfos.size() - 1)
-        return ItemInfo_v1();
+    if (!list || index < 0 || index >= list->size())
+        return nullptr;
 
-    return m_appLetterModeInfos.at(index);
+    return &list->at(index);
 }
 
 const ItemInfoList_v1 &AppsManager::windowedFrameItemInfoList()
@@ -1321,27 +1267,46 @@ bool AppsManager::appIsNewInstall(const QString &key)
 
 bool AppsManager::appIsAutoStart(const QString &desktop)
 {
-    return getAutostartValue().contains(desktop);
+    return APP_AUTOSTART_CACHE.contains(desktop);
 }
 
-bool AppsManager::appIsOnDock(const QString &desktop)
+bool AppsManager::appIsOnDock(const ItemInfo_v1 &info)
 {
-    return m_amDbusDockInter->IsDocked(desktop);
+    return m_appStatusTable->value(info, AppStatusTable::OnDock);
 }
 
-bool AppsManager::appIsOnDesktop(const QString &desktop)
+bool AppsManager::appIsOnDesktop(const ItemInfo_v1 &info)
 {
-    return m_amDbusLauncherInter->IsItemOnDesktop(desktop).value();
+    return m_appStatusTable->value(info, AppStatusTable::OnDesktop);
 }
 
-bool AppsManager::appIsProxy(const QString &desktop)
+bool AppsManager::appIsProxy(const ItemInfo_v1 &info)
 {
-    return m_amDbusLauncherInter->GetUseProxy(desktop).value();
+    return m_appStatusTable->value(info, AppStatusTable::UseProxy);
 }
 
-bool AppsManager::appIsEnableScaling(const QString &desktop)
+bool AppsManager::appIsEnableScaling(const ItemInfo_v1 &info)
 {
-    return !m_amDbusLauncherInter->GetDisableScaling(desktop);
+    return m_appStatusTable->value(info, AppStatusTable::EnableScaling);
+}
+
+/**
+ * @brief AppsManager::updateAppStatus 右键菜单修改应用状态后同步更新状态表
+ * @param desktop 应用的desktop全路径
+ * @param field 状态类型
+ * @param value 新的状态值
+ */
+void AppsManager::updateAppStatus(const QString &desktop, const AppStatusTable::Field field, const bool value)
+{
+    m_appStatusTable->setValue(desktop, field, value);
+}
+
+/**
+ * @brief AppsManager::prefetchAppStatus 启动器显示时异步查询所有应用的状态, 打开右键菜单时直接使用
+ */
+void AppsManager::prefetchAppStatus()
+{
+    m_appStatusTable->prefetch(m_allAppInfoList);
 }
 
 /**
@@ -1352,47 +1317,109 @@ bool AppsManager::appIsEnableScaling(const QString &desktop)
  */
 const QPixmap AppsManager::appIcon(const ItemInfo_v1 &info, const int size)
 {
-    QPixmap pix;
     const int iconSize = perfectIconSize(size);
+    if (info.m_iconKey.isEmpty())
+        return placeholderIcon(iconSize);
+
+    QPixmap pix;
+    const qreal ratio = qApp->devicePixelRatio();
+
+    const QString key = cacheKey(info, iconSize, ratio);
+    if (IconCacheManager::instance()->find(key, pix))
+        return pix;
 
-    m_itemInfo = info;
-    m_iconValid = getThemeIcon(pix, info, size);
-    if (m_iconValid) {
-        m_tryNums = 0;
+    // 冷启动时优先使用磁盘图集中的图标
+    if (IconAtlas::instance()->find(key, info.m_desktop, pix)) {
+        IconCacheManager::instance()->insert(key, pix);
         return pix;
     }
 
-    // 先返回齿轮，然后继续找
-    qreal ratio = qApp->devicePixelRatio();
-    QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
-    pix = icon.pixmap(QSize(iconSize, iconSize) * ratio);
-    pix.setDevicePixelRatio(ratio);
+    // 先返回齿轮, 图标在后台线程渲染完成后再通知界面刷新
+    IconRenderWorker::instance()->requestIcon(info, iconSize, ratio);
 
-    if (m_tryNums < 10) {
-        ++m_tryNums;
+    return placeholderIcon(iconSize);
+}
 
-        if (!QFile::exists(info.m_iconKey))
-            QIcon::setThemeSearchPaths(QIcon::themeSearchPaths());
+/**
+ * @brief AppsManager::syncAppIcon 在当前线程中获取app图片, 用于卸载弹窗、拖拽等需要立即显示图标的场景
+ * @param info app信息
+ * @param size app的长宽
+ * @return 图片对象
+ */
+const QPixmap AppsManager::syncAppIcon(const ItemInfo_v1 &info, const int size)
+{
+    QPixmap pix;
+    const int iconSize = perfectIconSize(size);
+    const QString key = cacheKey(info, iconSize, qApp->devicePixelRatio());
 
-        QTimer::singleShot(5 * 1000, this, &AppsManager::refreshIcon);
-    } else {
-        if (m_tryCount > 10)
-            return pix;
+    if (IconCacheManager::instance()->find(key, pix))
+        return pix;
 
-        ++m_tryCount;
-        QTimer::singleShot(10 * 1000, this, &AppsManager::refreshIcon);
+    if (IconAtlas::instance()->find(key, info.m_desktop, pix)) {
+        IconCacheManager::instance()->insert(key, pix);
+        return pix;
     }
+
+    if (!getThemeIcon(pix, info, size))
+        return placeholderIcon(iconSize);
+
+    IconCacheManager::instance()->insert(key, pix);
+    IconAtlas::instance()->insert(key, info.m_desktop, pix.toImage(), pix.devicePixelRatio());
     return pix;
 }
 
+/**
+ * @brief AppsManager::placeholderIcon 获取应用图标加载完成前显示的齿轮图标
+ * @param size 图标大小
+ * @return 图片对象
+ */
+const QPixmap AppsManager::placeholderIcon(const int size)
+{
+    const qreal ratio = qApp->devicePixelRatio();
+    const QString key = QString("application-x-desktop|%1|%2").arg(size).arg(ratio);
+
+    QPixmap pix;
+    if (IconCacheManager::instance()->find(key, pix))
+        return pix;
+
+    QIcon icon = QIcon(":/widgets/images/application-x-desktop.svg");
+    pix = icon.pixmap(QSize(size, size) * ratio);
+    pix.setDevicePixelRatio(ratio);
+
+    IconCacheManager::instance()->insert(key, pix);
+    return pix;
+}
+
+/**
+ * @brief AppsManager::onIconRendered 后台渲染的图标就绪后, 通知模型刷新对应的应用
+ * @param desktop 应用的desktop全路径
+ */
+void AppsManager::onIconRendered(const QString &desktop)
+{
+    const ItemInfo_v1 &info = getItemInfo(desktop);
+    if (info.m_desktop.isEmpty())
+        return;
+
+    emit itemDataChanged(info);
+}
+
 const QString AppsManager::appName(const ItemInfo_v1 &info, const int size)
 {
     const QFontMetrics fm = qApp->fontMetrics();
+    const QString &fm_string = fm.elidedText(appDisplayName(info), Qt::ElideRight, size);
+    return fm_string;
+}
+
+/**
+ * @brief AppsManager::appDisplayName 获取应用显示的名称, 开启配置时玲珑应用带有后缀
+ * @param info 应用信息
+ * @return 未省略的应用名称
+ */
+const QString AppsManager::appDisplayName(const ItemInfo_v1 &info) const
+{
     bool showSuffix = ConfigWorker::getValue(DLauncher::SHOW_LINGLONG_SUFFIX).toBool();
     bool isLingLongApp = info.isLingLongApp();
-    const QString &displayName = (showSuffix && isLingLongApp) ? (QString("%1(%2)").arg(info.m_name).arg(tr("LingLong"))) : info.m_name;
-    const QString &fm_string = fm.elidedText(displayName, Qt::ElideRight, size);
-    return fm_string;
+    return (showSuffix && isLingLongApp) ? (QString("%1(%2)").arg(info.m_name).arg(tr("LingLong"))) : info.m_name;
 }
 
 /**
@@ -1430,33 +1457,40 @@ void AppsManager::refreshCategoryInfoList()
     }
 
     sortByPresetOrder(m_allAppInfoList);
+    m_appRegistry.reindex();
+
+    // 更新搜索索引, 名称未变化的应用沿用原有索引项
+    AppSearchIndex::instance()->rebuild(m_allAppInfoList);
 
     // 2. 读取小窗口所有应用列表的缓存数据
-    m_windowedUsedSortedList = readCacheData(m_windowedUsedSortSetting->value("lists").toMap());
+    m_windowedUsedSortedList = m_windowedUsedSortStore->value("lists");
+
+    // 打开次数只保存在小窗口列表的缓存中, 同步到所有应用列表, 启动应用时在此基础上累加
+    for (const ItemInfo_v1 &itemInfo : m_windowedUsedSortedList) {
+        const int index = m_appRegistry.indexOf(itemInfo.m_desktop);
+        if (index != -1) {
+            m_allAppInfoList[index].m_openCount = itemInfo.m_openCount;
+            m_allAppInfoList[index].m_firstRunTime = itemInfo.m_firstRunTime;
+        }
+    }
+
+    hydrateSortedList(m_windowedUsedSortedList);
 
     // 缓存数据中没有的, 则加入到所有应用列表中
+    AppRegistry windowedRegistry(m_windowedUsedSortedList);
     for (const ItemInfo_v1 &itemInfo : m_allAppInfoList) {
-        if (!contains(m_windowedUsedSortedList, itemInfo)) {
+        if (!windowedRegistry.contains(itemInfo)) {
             m_windowedUsedSortedList.append(itemInfo);
-        } else {
-            // 多语言时，更新应用信息
-            int index = itemIndex(m_windowedUsedSortedList, itemInfo);
-            if (index != -1)
-                m_windowedUsedSortedList[index].updateInfo(itemInfo);
+            windowedRegistry.indexAppendedRow();
         }
     }
 
+    // 缓存数据中记录了应用的打开次数, 用于搜索结果排序
+    AppSearchIndex::instance()->updateUsage(m_windowedUsedSortedList);
+
     // 3. 读取全屏下所有应用列表的缓存数据
-    // 为兼容历史版本, 1050以前使用list, v23即以后使用lists作为键值
-    if (APP_USED_SORTED_LIST.contains("list")) {
-        ItemInfoList oldUsedSortedList;
-        QByteArray usedBuf = APP_USED_SORTED_LIST.value("list").toByteArray();
-        QDataStream in(&usedBuf, QIODevice::ReadOnly);
-        in >> oldUsedSortedList;
-        m_fullscreenUsedSortedList = ItemInfo_v1::itemListToItemV1List(oldUsedSortedList);
-    } else {
-        m_fullscreenUsedSortedList = readCacheData(m_fullscreenUsedSortSetting->value("lists").toMap());
-    }
+    m_fullscreenUsedSortedList = m_fullscreenUsedSortStore->value("lists");
+    hydrateSortedList(m_fullscreenUsedSortedList);
 
     for (const ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
         if (fuzzyMatching(filters, info.m_key))
@@ -1466,25 +1500,14 @@ void AppsManager::refreshCategoryInfoList()
     // 4. 从缓存中读取已分类的应用数据, 降低数据处理次数
     if (m_appInfos.isEmpty()) {
         for (int categoryIndex = AppsListModel::Internet; categoryIndex < static_cast<int>(AppsListModel::Others); categoryIndex++) {
-            ItemInfoList_v1 itemInfoList_v1 = m_appInfos.value(AppsListModel::AppCategory(categoryIndex));
-
-            // 读取1050缓存的话，需要减去(v23阶段)新增的4个枚举变量的偏移值
-            int originCategoryIndex = categoryIndex - 4;
-            if (APP_CATEGORY_USED_SORTED_LIST.contains(QString("%1").arg(originCategoryIndex))) {
-                ItemInfoList itemInfoList;
-                QByteArray categoryBuf = APP_CATEGORY_USED_SORTED_LIST.value(QString("%1").arg(originCategoryIndex)).toByteArray();
-                QDataStream categoryIn(&categoryBuf, QIODevice::ReadOnly);
-                categoryIn >> itemInfoList;
-                itemInfoList_v1 = ItemInfo_v1::itemListToItemV1List(itemInfoList);
-            } else if (m_categorySetting->contains(QString("lists_%1").arg(categoryIndex))) {
-                itemInfoList_v1 = readCacheData(m_categorySetting->value(QString("lists_%1").arg(categoryIndex)).toMap());
-            }
+            ItemInfoList_v1 itemInfoList_v1 = m_categoryStore->value(QString("lists_%1").arg(categoryIndex));
+            hydrateSortedList(itemInfoList_v1);
 
             ItemInfoList_v1 list_ToRemove;
             for (const ItemInfo_v1 &info : itemInfoList_v1) {
-                int index = itemIndex(m_allAppInfoList, info);
+                int index = m_appRegistry.indexOf(info);
                 // 当缓存数据与应用商店数据有差异时，以应用商店数据为准
-                if (index != -1 && m_allAppInfoList.at(index).category() != info.category())
+                if (index != -1 && info.category() != AppsListModel::AppCategory(categoryIndex))
                     list_ToRemove.append(info);
 
                 // 如果应用已经卸载，从更新缓存数据列表
@@ -1496,12 +1519,6 @@ void AppsManager::refreshCategoryInfoList()
                 itemInfoList_v1.removeOne(info);
 
             m_appInfos.insert(AppsListModel::AppCategory(categoryIndex), itemInfoList_v1);
-
-            if (categoryIndex == static_cast<int>(AppsListModel::System) && QFileInfo::exists(APP_CATEGORY_USED_SORTED_LIST.fileName())) {
-                QDir removeCacheFileDir;
-                removeCacheFileDir.remove(APP_CATEGORY_USED_SORTED_LIST.fileName());
-                qDebug() << "remove dde-launcher-app-category-used-sorted-list conf file success!";
-            }
         }
     }
 
@@ -1517,6 +1534,8 @@ void AppsManager::refreshItemInfoList()
 {
     if (m_fullscreenUsedSortedList.isEmpty())
         m_fullscreenUsedSortedList = m_allAppInfoList;
+    else
+        hydrateSortedList(m_fullscreenUsedSortedList);
 
     // 获取所有文件夹下的应用列表
     ItemInfoList_v1 dirAppInfoList;
@@ -1526,35 +1545,25 @@ void AppsManager::refreshItemInfoList()
     }
 
     // 更新全屏窗口-所有应用列表
+    // 在全屏应用列表以及文件夹中都不存在时，才加入到最后
+    AppRegistry fullscreenRegistry(m_fullscreenUsedSortedList);
+    const AppRegistry dirAppRegistry(dirAppInfoList);
     ItemInfoList_v1::ConstIterator allItemItor = m_allAppInfoList.constBegin();
     for (; allItemItor != m_allAppInfoList.constEnd(); ++allItemItor) {
-        // 在全屏列表中存在或者文件夹中存在时，就更新应用信息
-        // 在全屏应用列表以及文件夹中都不存在时，才加入到最后
-        if (!contains(m_fullscreenUsedSortedList, *allItemItor)) {
-            for (ItemInfo_v1 &fullItemInfo : m_fullscreenUsedSortedList) {
-
-                if (!fullItemInfo.m_isDir)
-                    continue;
-
-                if (!contains(dirAppInfoList, *allItemItor)) {
-                    m_fullscreenUsedSortedList.append(*allItemItor);
-                } else {
-                    int index = itemIndex(fullItemInfo.m_appInfoList, *allItemItor);
-                    if (index != -1)
-                        fullItemInfo.m_appInfoList[index].updateInfo(*allItemItor);
-                }
+        if (fullscreenRegistry.contains(*allItemItor))
+            continue;
+
+        for (int i = 0; i < m_fullscreenUsedSortedList.size(); ++i) {
+            if (m_fullscreenUsedSortedList.at(i).m_isDir && !dirAppRegistry.contains(*allItemItor)) {
+                m_fullscreenUsedSortedList.append(*allItemItor);
+                fullscreenRegistry.indexAppendedRow();
             }
-        } else {
-            // 更新应用信息(譬如，语言切换时会受用）
-            int index = itemIndex(m_fullscreenUsedSortedList, *allItemItor);
-            if (index != -1)
-                m_fullscreenUsedSortedList[index].updateInfo(*allItemItor);
         }
     }
 
     ItemInfoList_v1 list_toRemove;
     for (const ItemInfo_v1 &info : m_fullscreenUsedSortedList) {
-        if (!contains(m_allAppInfoList, info))
+        if (!m_appRegistry.contains(info))
             list_toRemove.append(info);
     }
 
@@ -1564,7 +1573,7 @@ void AppsManager::refreshItemInfoList()
         // 否则，将文件夹中本地不存在的应用删除
         if (info.m_isDir) {
             for (const ItemInfo_v1 &appInfo : info.m_appInfoList) {
-                if (!contains(m_allAppInfoList, appInfo)) {
+                if (!m_appRegistry.contains(appInfo)) {
                     const int index = itemIndex(m_fullscreenUsedSortedList, info);
                     m_fullscreenUsedSortedList[index].m_appInfoList.removeOne(appInfo);
                 }
@@ -1581,27 +1590,19 @@ void AppsManager::refreshItemInfoList()
             m_fullscreenUsedSortedList.removeOne(dirItemInfo);
     }
 
-    // 移除小窗口-所有应用列表中不存在的应用
-    // 更新应用信息
-    for (ItemInfo_v1 &info : m_windowedUsedSortedList) {
-        if (!contains(m_allAppInfoList, info)) {
-            m_windowedUsedSortedList.removeOne(info);
-        } else {
-            int index = itemIndex(m_allAppInfoList, info);
-            info.updateInfo(m_allAppInfoList.at(index));
+    // 更新应用信息, 移除小窗口-所有应用列表及收藏列表中不存在的应用
+    auto updateItems = [ & ](ItemInfoList_v1 &list) {
+        hydrateSortedList(list);
+        for (auto it(list.begin()); it != list.end();) {
+            if (!m_appRegistry.contains(*it))
+                it = list.erase(it);
+            else
+                ++it;
         }
-    }
+    };
 
-    // 移除收藏列表中不存在的应用
-    // 更新应用信息
-    for (ItemInfo_v1 &info : m_favoriteSortedList) {
-        if (!contains(m_allAppInfoList, info)) {
-            m_favoriteSortedList.removeOne(info);
-        } else {
-            int index = itemIndex(m_allAppInfoList, info);
-            info.updateInfo(m_allAppInfoList.at(index));
-        }
-    }
+    updateItems(m_windowedUsedSortedList);
+    updateItems(m_favoriteSortedList);
 
     // 对小窗口所有应用列表按照使用频率进行排序
     sortByUseFrequence(m_windowedUsedSortedList);
@@ -1617,23 +1618,34 @@ void AppsManager::saveAppCategoryInfoList()
     QHash<AppsListModel::AppCategory, ItemInfoList_v1>::iterator categoryAppsIter = m_appInfos.begin();
     for (; categoryAppsIter != m_appInfos.end(); ++categoryAppsIter) {
         int category = categoryAppsIter.key();
-        m_categorySetting->setValue(QString("lists_%1").arg(category), getCacheMapData(categoryAppsIter.value()));
+        m_categoryStore->setValue(QString("lists_%1").arg(category), categoryAppsIter.value());
     }
 }
 
 void AppsManager::generateCategoryMap()
 {
+    // 梳理应用分类数据, 为后续小窗口标题模式提供数据
+    // 先创建所有分类, 避免建立索引后插入新分类导致索引引用的列表失效
     for (const ItemInfo_v1 &info : m_allAppInfoList) {
-        // 梳理应用分类数据, 为后续小窗口标题模式提供数据
         const AppsListModel::AppCategory category = info.category();
         if (!m_appInfos.contains(category))
             m_appInfos.insert(category, ItemInfoList_v1());
+    }
 
-        const int idx = itemIndex(m_appInfos[category], info);
-        if (idx == -1)
-            m_appInfos[category].append(info);
-        else
-            m_appInfos[category][idx].updateInfo(info);
+    for (auto it = m_appInfos.begin(); it != m_appInfos.end(); ++it) {
+        ItemInfoList_v1 &categoryList = it.value();
+        AppRegistry categoryRegistry(categoryList);
+
+        for (const ItemInfo_v1 &info : m_allAppInfoList) {
+            if (info.category() != it.key())
+                continue;
+
+            // 分类列表中的应用信息已在 removeNonexistentData() 中更新
+            if (!categoryRegistry.contains(info)) {
+                categoryList.append(info);
+                categoryRegistry.indexAppendedRow();
+            }
+        }
     }
 
     getCategoryListAndSortCategoryId();
@@ -1676,17 +1688,56 @@ void AppsManager::generateLetterCategoryList()
 
 void AppsManager::readCollectedCacheData()
 {
-    const QString &filePath = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation)
-            + QString("/%1/dde-launcher-app-collect-list.json").arg(qApp->organizationName());
-
-    if (!QFile::exists(filePath)) {
+    if (!m_collectedStore->contains("lists")) {
         // 获取小窗口默认收藏列表
         loadDefaultFavoriteList(m_allAppInfoList);
 
         // 缓存小窗口收藏列表
         saveCollectedSortedList();
     } else {
-        m_favoriteSortedList = readCacheData(m_collectedSetting->value("lists").toMap());
+        m_favoriteSortedList = m_collectedStore->value("lists");
+        hydrateSortedList(m_favoriteSortedList);
+    }
+}
+
+/**
+ * @brief AppsManager::hydrateSortedList 缓存中只保存应用的 desktop、文件夹名称及使用次数, 其他信息从 m_allAppInfoList 中补全
+ * @param list 排序列表, 不存在的应用保持不变, 由调用方移除
+ */
+void AppsManager::hydrateSortedList(ItemInfoList_v1 &list) const
+{
+    for (ItemInfo_v1 &info : list) {
+        if (info.m_isDir) {
+            // 文件夹沿用创建时释放对象的 key、图标及分类, desktop 为释放对象的 desktop 加上 .dir 后缀
+            QString desktop = info.m_desktop;
+            if (desktop.endsWith(".dir"))
+                desktop.chop(4);
+
+            const int index = m_appRegistry.indexOf(desktop);
+            if (index != -1) {
+                const ItemInfo_v1 &appInfo = m_allAppInfoList.at(index);
+                info.m_key = appInfo.m_key;
+                info.m_iconKey = appInfo.m_iconKey;
+                info.m_categoryId = appInfo.m_categoryId;
+            }
+
+            hydrateSortedList(info.m_appInfoList);
+            continue;
+        }
+
+        const int index = m_appRegistry.indexOf(info.m_desktop);
+        if (index == -1)
+            continue;
+
+        const qlonglong openCount = info.m_openCount;
+        const qlonglong firstRunTime = info.m_firstRunTime;
+        info = m_allAppInfoList.at(index);
+
+        // 所有应用列表中没有打开记录时, 保持缓存中的数据
+        if (info.m_openCount == 0)
+            info.m_openCount = openCount;
+        if (info.m_firstRunTime == 0)
+            info.m_firstRunTime = firstRunTime;
     }
 }
 
@@ -1696,58 +1747,173 @@ int AppsManager::appNums(const AppsListModel::AppCategory &category)
 }
 
 /**
- * @brief AppsManager::refreshAppAutoStartCache 刷新自启动应用集
+ * @brief AppsManager::refreshAppAutoStartCache 根据自启动变化信号更新自启动应用集
  * @param type 操作类型
  * @param desktpFilePath 应用路径
  */
 void AppsManager::refreshAppAutoStartCache(const QString &type, const QString &desktpFilePath)
 {
-    if (type.isEmpty()) {
-        APP_AUTOSTART_CACHE.clear();
-        const QStringList &desktop_list = m_startManagerInter->AutostartList().value();
+    if (desktpFilePath.isEmpty())
+        return;
 
-        for (const QString &auto_start_desktop : desktop_list) {
-            const QString desktop_file_name = auto_start_desktop.split("/").last();
+    // AutostartList 的查询结果可能早于这次变化, 记录下来在结果返回后重新应用
+    if (m_autostartListLoading && (type == "added" || type == "deleted"))
+        m_pendingAutostartChanges[desktpFilePath] = (type == "added");
+
+    // 记录应用的desktop全路径，区分不同包格式的同一应用，避免都绘制出自启动的样式
+    bool changed = false;
+    if (type == "added") {
+        changed = !APP_AUTOSTART_CACHE.contains(desktpFilePath);
+        APP_AUTOSTART_CACHE.insert(desktpFilePath);
+    } else if (type == "deleted") {
+        changed = APP_AUTOSTART_CACHE.remove(desktpFilePath);
+    }
 
-            if (!desktop_file_name.isEmpty())
-                APP_AUTOSTART_CACHE.insert(desktop_file_name);
-        }
-    } else {
-        const QString desktop_file_name = desktpFilePath.split("/").last();
+    if (!changed)
+        return;
+
+    scheduleSaveAutostartCache();
+    emit dataChanged(AppsListModel::FullscreenAll);
+}
+
+/**
+ * @brief AppsManager::migrateLegacySortedLists 将1050及以前版本以 QDataStream 保存的排序列表迁移到快照中, 迁移后删除原有数据
+ * 原有数据在迁移前总是优先于新格式的数据, 迁移时保持这一规则
+ */
+void AppsManager::migrateLegacySortedLists()
+{
+    // 1050以前使用list, v23即以后使用lists作为键值
+    if (APP_USED_SORTED_LIST.contains("list")) {
+        ItemInfoList oldUsedSortedList;
+        QByteArray usedBuf = APP_USED_SORTED_LIST.value("list").toByteArray();
+        QDataStream in(&usedBuf, QIODevice::ReadOnly);
+        in >> oldUsedSortedList;
+        m_fullscreenUsedSortStore->setValue("lists", ItemInfo_v1::itemListToItemV1List(oldUsedSortedList));
+
+        APP_USED_SORTED_LIST.remove("list");
+        APP_USED_SORTED_LIST.sync();
+        m_fullscreenUsedSortStore->flush();
+    }
+
+    if (!QFileInfo::exists(APP_CATEGORY_USED_SORTED_LIST.fileName()))
+        return;
 
-        if (desktop_file_name.isEmpty())
+    for (int categoryIndex = AppsListModel::Internet; categoryIndex < static_cast<int>(AppsListModel::Others); categoryIndex++) {
+        // 读取1050缓存的话，需要减去(v23阶段)新增的4个枚举变量的偏移值
+        const QString originCategoryKey = QString::number(categoryIndex - 4);
+        if (!APP_CATEGORY_USED_SORTED_LIST.contains(originCategoryKey))
+            continue;
+
+        ItemInfoList itemInfoList;
+        QByteArray categoryBuf = APP_CATEGORY_USED_SORTED_LIST.value(originCategoryKey).toByteArray();
+        QDataStream categoryIn(&categoryBuf, QIODevice::ReadOnly);
+        categoryIn >> itemInfoList;
+        m_categoryStore->setValue(QString("lists_%1").arg(categoryIndex), ItemInfo_v1::itemListToItemV1List(itemInfoList));
+    }
+
+    m_categoryStore->flush();
+
+    QDir removeCacheFileDir;
+    removeCacheFileDir.remove(APP_CATEGORY_USED_SORTED_LIST.fileName());
+    qDebug() << "remove dde-launcher-app-category-used-sorted-list conf file success!";
+}
+
+/**
+ * @brief AppsManager::loadAutostartCache 初始化自启动应用集, 先使用上次保存的列表, 再以异步获取的 AutostartList 为准
+ * 查询期间收到的自启动变化比查询结果新, 在结果之上重新应用
+ */
+void AppsManager::loadAutostartCache()
+{
+    APP_AUTOSTART_CACHE.clear();
+    const QStringList savedList = m_autostartDesktopListSetting->value(AUTOSTART_KEY).toStringList();
+    for (const QString &desktop : savedList)
+        APP_AUTOSTART_CACHE.insert(desktop);
+
+    m_autostartListLoading = true;
+    m_pendingAutostartChanges.clear();
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(m_startManagerInter->AutostartList(), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ this ](QDBusPendingCallWatcher *call) {
+        call->deleteLater();
+
+        const QHash<QString, bool> pendingChanges = m_pendingAutostartChanges;
+        m_autostartListLoading = false;
+        m_pendingAutostartChanges.clear();
+
+        // 查询失败时保留上次保存的列表及查询期间已应用的变化
+        const QDBusPendingReply<QStringList> reply = *call;
+        if (reply.isError()) {
+            qWarning() << "get autostart list failed:" << reply.error().message();
             return;
+        }
 
-        // 记录插入的应用的desktop全路径，区分不同包格式的同一应用，避免都绘制出自启动的样式
-        QStringList autostartList = getAutostartValue();
-        if (type == "added") {
-            APP_AUTOSTART_CACHE.insert(desktop_file_name);
+        const QStringList autostartList = reply.value();
+        QSet<QString> fileNames;
+        for (const QString &desktop : autostartList)
+            fileNames.insert(QFileInfo(desktop).fileName());
+
+        // 已记录全路径的应用沿用记录, 不再按文件名匹配其他包格式的同名应用
+        QSet<QString> autostartCache;
+        QSet<QString> recordedNames;
+        for (const QString &desktop : APP_AUTOSTART_CACHE) {
+            const QString fileName = QFileInfo(desktop).fileName();
+            if (fileNames.contains(fileName)) {
+                autostartCache.insert(desktop);
+                recordedNames.insert(fileName);
+            }
+        }
 
-            if (!autostartList.contains(desktpFilePath)) {
-                autostartList.append(desktpFilePath);
-                setAutostartValue(autostartList);
+        // 返回的路径可能位于自启动目录, 按desktop文件名对应到应用
+        for (const QString &desktop : autostartList) {
+            const QString fileName = QFileInfo(desktop).fileName();
+            if (recordedNames.contains(fileName))
+                continue;
+
+            if (m_appRegistry.indexOf(desktop) != -1) {
+                autostartCache.insert(desktop);
+                continue;
             }
-        } else if (type == "deleted") {
-            APP_AUTOSTART_CACHE.remove(desktop_file_name);
 
-            if (autostartList.contains(desktpFilePath)) {
-                autostartList.removeOne(desktpFilePath);
-                setAutostartValue(autostartList);
+            for (const ItemInfo_v1 &info : m_allAppInfoList) {
+                if (QFileInfo(info.m_desktop).fileName() == fileName)
+                    autostartCache.insert(info.m_desktop);
             }
         }
 
+        for (auto it = pendingChanges.constBegin(); it != pendingChanges.constEnd(); ++it) {
+            if (it.value())
+                autostartCache.insert(it.key());
+            else
+                autostartCache.remove(it.key());
+        }
+
+        if (autostartCache == APP_AUTOSTART_CACHE)
+            return;
+
+        APP_AUTOSTART_CACHE.swap(autostartCache);
+        scheduleSaveAutostartCache();
         emit dataChanged(AppsListModel::FullscreenAll);
-    }
+    });
 }
 
-void AppsManager::setAutostartValue(const QStringList &list)
+/**
+ * @brief AppsManager::saveAutostartCache 将自启动应用集写入配置文件
+ */
+void AppsManager::saveAutostartCache()
 {
+    QStringList list = APP_AUTOSTART_CACHE.values();
+    list.sort();
+
     m_autostartDesktopListSetting->setValue(AUTOSTART_KEY, list);
+    m_autostartDesktopListSetting->sync();
 }
 
-QStringList AppsManager::getAutostartValue() const
+/**
+ * @brief AppsManager::scheduleSaveAutostartCache 延迟写入配置文件, 连续的修改只写入一次
+ */
+void AppsManager::scheduleSaveAutostartCache()
 {
-    return m_autostartDesktopListSetting->value(AUTOSTART_KEY).toStringList();
+    m_saveAutostartTimer->start();
 }
 
 /**
@@ -1760,7 +1926,27 @@ void AppsManager::handleItemChanged(const QString &operation, const ItemInfo_v2
 {
     Q_UNUSED(categoryNumber);
 
-    ItemInfo_v1 info(appInfo);
+    applyItemChange(operation, ItemInfo_v1(appInfo));
+}
+
+void AppsManager::handleItemChanged(const QString &operation, const ItemInfo &appInfo, qlonglong categoryNumber)
+{
+    Q_UNUSED(categoryNumber);
+
+    applyItemChange(operation, ItemInfo_v1(appInfo));
+}
+
+/**
+ * @brief AppsManager::applyItemChange 只更新变化的应用所在的各个列表, 不重新获取所有应用及重建分类
+ * 所有应用、小窗口、全屏(含文件夹)、收藏及分类列表逐行更新并发送行插入、删除信号, 标题模式及字母模式的列表延迟重新生成
+ * @param operation 操作类型, created、deleted 或 updated
+ * @param info 操作的应用信息
+ */
+void AppsManager::applyItemChange(const QString &operation, const ItemInfo_v1 &info)
+{
+    // 应用安装、卸载、更新后, 图标可能变化, 移除缓存的图标
+    IconCacheManager::instance()->removeItem(info.m_desktop);
+    IconAtlas::instance()->removeItem(info.m_desktop);
 
     //　更新应用到缓存
     emit loadItem(info, operation);
@@ -1770,86 +1956,187 @@ void AppsManager::handleItemChanged(const QString &operation, const ItemInfo_v2
         if (fuzzyMatching(filters, info.m_key))
             return;
 
-        m_allAppInfoList.append(info);
-        m_fullscreenUsedSortedList.append(info);
-        m_windowedUsedSortedList.insert(0, info);
+        // 重复收到安装信号时按更新处理
+        if (m_appRegistry.indexOf(info.m_desktop) == -1)
+            insertApp(info);
+        else
+            updateApp(info);
     } else if (operation == "deleted") {
-        m_allAppInfoList.removeOne(info);
-        m_fullscreenUsedSortedList.removeOne(info);
+        removeApp(info.m_desktop);
     } else if (operation == "updated") {
-        Q_ASSERT(contains(m_allAppInfoList, info));
-
-        // 更新所有应用列表
-        int index = itemIndex(m_allAppInfoList, info);
-        if (index != -1)
-            m_allAppInfoList[index].updateInfo(info);
-
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_fullscreenUsedSortedList, info);
-        if (index != -1)
-            m_fullscreenUsedSortedList[index].updateInfo(info);
-
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_windowedUsedSortedList, info);
-        if (index != -1)
-            m_windowedUsedSortedList[index].updateInfo(info);
+        if (m_appRegistry.indexOf(info.m_desktop) == -1)
+            insertApp(info);
+        else
+            updateApp(info);
     } else {
         qDebug() << "nonexistent condition, operation:" << operation;
         return;
     }
 
+    // 标题模式及字母模式的列表需要对所有应用重新分组排序, 大量应用连续更新时只生成一次
+    m_refreshGroupListsTimer->start();
+
     saveFullscreenUsedSortedList();
     saveWidowedUsedSortedList();
+    saveCollectedSortedList();
+    saveAppCategoryInfoList();
+}
 
-    m_delayRefreshTimer->start();
+/**
+ * @brief AppsManager::refreshGroupLists 标题模式及字母模式的列表带有分组标题, 由分类列表及所有应用列表重新生成
+ */
+void AppsManager::refreshGroupLists()
+{
+    getCategoryListAndSortCategoryId();
+    generateTitleCategoryList();
+    generateLetterCategoryList();
+    emit dataChanged(AppsListModel::TitleMode);
+    emit dataChanged(AppsListModel::LetterMode);
 }
 
-void AppsManager::handleItemChanged(const QString &operation, const ItemInfo &appInfo, qlonglong categoryNumber)
+/**
+ * @brief AppsManager::insertApp 新安装的应用加入所有应用列表末尾、小窗口列表开头、全屏列表末尾及所属分类的末尾
+ * @param info 应用信息
+ */
+void AppsManager::insertApp(const ItemInfo_v1 &info)
 {
-    Q_UNUSED(categoryNumber);
+    m_allAppInfoList.append(info);
+    m_appRegistry.indexAppendedRow();
+    AppSearchIndex::instance()->update(info);
 
-    ItemInfo_v1 info(appInfo);
-    //　更新应用到缓存
-    emit loadItem(info, operation);
+    if (!m_newInstalledAppsList.contains(info.m_key))
+        m_newInstalledAppsList.append(info.m_key);
 
-    if (operation == "created") {
-        QStringList filters = SettingValue("com.deepin.dde.launcher", "/com/deepin/dde/launcher/", "filter-keys").toStringList();
-        if (fuzzyMatching(filters, info.m_key))
-            return;
+    m_windowedUsedSortedList.prepend(info);
+    emit itemInserted(AppsListModel::WindowedAll, 0);
 
-        m_allAppInfoList.append(info);
-        m_fullscreenUsedSortedList.append(info);
-        m_windowedUsedSortedList.insert(0, info);
-    } else if (operation == "deleted") {
-        m_allAppInfoList.removeOne(info);
-        m_fullscreenUsedSortedList.removeOne(info);
-        m_windowedUsedSortedList.removeOne(info);
-        //一般情况是不需要的，但是类似wps这样的程序有点特殊，删除一个其它的二进制程序也删除了，需要保存列表，否则刷新的时候会刷新出齿轮的图标
-        //新增和更新则无必要
-        saveFullscreenUsedSortedList();
-        saveWidowedUsedSortedList();
-    } else if (operation == "updated") {
-        Q_ASSERT(contains(m_allAppInfoList, info));
-        // 更新所有应用列表
-        int index = itemIndex(m_allAppInfoList, info);
-        if (index != -1)
-            m_allAppInfoList[index].updateInfo(info);
+    m_fullscreenUsedSortedList.append(info);
+    emit itemInserted(AppsListModel::FullscreenAll, m_fullscreenUsedSortedList.size() - 1);
 
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_fullscreenUsedSortedList, info);
-        if (index != -1)
-            m_fullscreenUsedSortedList[index].updateInfo(info);
+    ItemInfoList_v1 &categoryList = m_appInfos[info.category()];
+    categoryList.append(info);
+    emit itemInserted(info.category(), categoryList.size() - 1);
+}
 
-        // 更新按照最近使用顺序排序的列表
-        index = itemIndex(m_windowedUsedSortedList, info);
-        if (index != -1)
-            m_windowedUsedSortedList[index].updateInfo(info);
-    } else {
-        qDebug() << "nonexistent condition, operation:" << operation;
-        return;
+/**
+ * @brief AppsManager::updateApp 更新各列表中应用的信息, 保持打开次数等使用记录, 分类变化时移动到新的分类
+ * @param info 应用信息
+ */
+void AppsManager::updateApp(const ItemInfo_v1 &info)
+{
+    const int row = m_appRegistry.indexOf(info.m_desktop);
+    const ItemInfo_v1 oldInfo = m_allAppInfoList.at(row);
+
+    ItemInfo_v1 appInfo = info;
+    appInfo.m_openCount = qMax(info.m_openCount, oldInfo.m_openCount);
+    if (appInfo.m_firstRunTime == 0)
+        appInfo.m_firstRunTime = oldInfo.m_firstRunTime;
+    if (appInfo.m_key == "dde-trash")
+        appInfo.m_iconKey = m_trashIsEmpty ? "user-trash" : "user-trash-full";
+
+    m_allAppInfoList[row] = appInfo;
+
+    // key 变化时只能重新建立索引
+    if (appInfo.m_key != oldInfo.m_key)
+        m_appRegistry.reindex();
+
+    AppSearchIndex::instance()->update(appInfo);
+
+    // 分类变化时从原分类移动到新分类的末尾
+    const AppsListModel::AppCategory oldCategory = oldInfo.category();
+    const AppsListModel::AppCategory category = appInfo.category();
+    if (oldCategory != category && m_appInfos.contains(oldCategory)) {
+        ItemInfoList_v1 &oldCategoryList = m_appInfos[oldCategory];
+        const int categoryRow = desktopIndex(oldCategoryList, appInfo.m_desktop);
+        if (categoryRow != -1) {
+            oldCategoryList.removeAt(categoryRow);
+            emit itemRemoved(oldCategory, categoryRow);
+
+            ItemInfoList_v1 &categoryList = m_appInfos[category];
+            categoryList.append(appInfo);
+            emit itemInserted(category, categoryList.size() - 1);
+        }
     }
 
-    m_delayRefreshTimer->start();
+    replaceAppInfo(m_windowedUsedSortedList, appInfo);
+    replaceAppInfo(m_fullscreenUsedSortedList, appInfo);
+    replaceAppInfo(m_favoriteSortedList, appInfo);
+    replaceAppInfo(m_dirAppInfoList, appInfo);
+    if (m_appInfos.contains(category))
+        replaceAppInfo(m_appInfos[category], appInfo);
+
+    emit itemDataChanged(appInfo);
+}
+
+/**
+ * @brief AppsManager::removeApp 从各列表及文件夹中移除卸载的应用, 文件夹中只剩一个应用时由该应用代替文件夹
+ * @param desktop 应用的desktop全路径
+ */
+void AppsManager::removeApp(const QString &desktop)
+{
+    const int row = m_appRegistry.indexOf(desktop);
+    if (row == -1)
+        return;
+
+    const ItemInfo_v1 info = m_allAppInfoList.takeAt(row);
+    m_appRegistry.indexRemovedRow(row, info.m_desktop, info.m_key);
+    AppSearchIndex::instance()->remove(desktop);
+    m_appStatusTable->remove(desktop);
+    m_newInstalledAppsList.removeOne(info.m_key);
+
+    auto removeFromList = [ & ](ItemInfoList_v1 &list, const AppsListModel::AppCategory category) {
+        const int index = desktopIndex(list, desktop);
+        if (index != -1) {
+            list.removeAt(index);
+            emit itemRemoved(category, index);
+        }
+    };
+
+    removeFromList(m_windowedUsedSortedList, AppsListModel::WindowedAll);
+    removeFromList(m_favoriteSortedList, AppsListModel::Favorite);
+    removeFromList(m_fullscreenUsedSortedList, AppsListModel::FullscreenAll);
+    if (m_appInfos.contains(info.category()))
+        removeFromList(m_appInfos[info.category()], info.category());
+
+    for (int i = 0; i < m_fullscreenUsedSortedList.size(); ++i) {
+        ItemInfo_v1 &dirInfo = m_fullscreenUsedSortedList[i];
+        if (!dirInfo.m_isDir)
+            continue;
+
+        const int index = desktopIndex(dirInfo.m_appInfoList, desktop);
+        if (index == -1)
+            continue;
+
+        const bool isOpened = (dirInfo.m_appInfoList == m_dirAppInfoList);
+        dirInfo.m_appInfoList.removeAt(index);
+
+        if (dirInfo.m_appInfoList.size() > 1) {
+            if (isOpened) {
+                m_dirAppInfoList.removeAt(index);
+                emit itemRemoved(AppsListModel::Dir, index);
+            }
+
+            emit itemDataChanged(dirInfo);
+            break;
+        }
+
+        // 文件夹中只剩一个应用时，把剩余的这个应用放置在原文件夹的位置，并清除文件夹样式
+        const ItemInfoList_v1 remainList = dirInfo.m_appInfoList;
+        m_fullscreenUsedSortedList.removeAt(i);
+        emit itemRemoved(AppsListModel::FullscreenAll, i);
+
+        if (!remainList.isEmpty()) {
+            m_fullscreenUsedSortedList.insert(i, remainList.first());
+            emit itemInserted(AppsListModel::FullscreenAll, i);
+        }
+
+        // 文件夹已不存在, 关闭文件夹展开窗口
+        if (isOpened) {
+            m_dirAppInfoList.clear();
+            emit requestHidePopup();
+        }
+        break;
+    }
 }
 
 /**
@@ -2052,5 +2339,14 @@ void AppsManager::updateTrashState()
         return;
 
     m_trashIsEmpty = !trashItemsCount;
+
+    // 回收站图标在空和非空之间切换, 移除缓存的旧图标
+    for (const ItemInfo_v1 &info : m_allAppInfoList) {
+        if (info.m_key == "dde-trash") {
+            IconCacheManager::instance()->removeItem(info.m_desktop);
+            IconAtlas::instance()->removeItem(info.m_desktop);
+        }
+    }
+
     emit dataChanged(AppsListModel::FullscreenAll);
 }
@@ -6,6 +6,9 @@
 #define APPSMANAGER_H
 
 #include "appslistmodel.h"
+#include "appregistry.h"
+#include "appstatustable.h"
+#include "sortedliststore.h"
 #include "dbustartmanager.h"
 #include "calculate_util.h"
 #include "common.h"
@@ -68,17 +71,11 @@ public:
     void updateUsedSortData(QModelIndex dragIndex, QModelIndex dropIndex);
     void updateDrawerTitle(const QModelIndex &index, const QString &newTitle = QString());
     QList<QPixmap> getDirAppIcon(QModelIndex modelIndex);
-    void showSearchedData(const AppInfoList &list);
+    void appendSearchedData(const AppInfoList &list);
+    void clearSearchedData();
     const ItemInfo_v1 getItemInfo(const QString &desktop);
     void dropToCollected(const ItemInfo_v1 &info, const int row);
 
-    static bool readJsonFile(QIODevice &device, QSettings::SettingsMap &map);
-    static bool writeJsonFile(QIODevice &device, const QSettings::SettingsMap &map);
-    void registerSettingsFormat();
-
-    QSettings::SettingsMap getCacheMapData(const ItemInfoList_v1 &list);
-    const ItemInfoList_v1 readCacheData(const QSettings::SettingsMap &map);
-
     void setDragMode(const DragMode &mode);
     DragMode getDragMode() const;
 
@@ -114,6 +111,8 @@ public:
 
 signals:
     void itemDataChanged(const ItemInfo_v1 &info) const;
+    void itemInserted(const AppsListModel::AppCategory category, const int row) const;
+    void itemRemoved(const AppsListModel::AppCategory category, const int row) const;
     void dataChanged(const AppsListModel::AppCategory category) const;
     void layoutChanged(const AppsListModel::AppCategory category) const;
     void requestTips(const QString &tips) const;
@@ -141,9 +140,7 @@ public slots:
     void setDirAppInfoList(const QModelIndex index);
     int appsInfoListSize(const AppsListModel::AppCategory &category);
     const ItemInfoList_v1 appsInfoList(const AppsListModel::AppCategory &category) const;
-    const ItemInfo_v1 appsInfoListIndex(const AppsListModel::AppCategory &category,const int index);
-    const ItemInfo_v1 appsCategoryListIndex(const int index);
-    const ItemInfo_v1 appsLetterListIndex(const int index);
+    const ItemInfo_v1 *appsInfoListItem(const AppsListModel::AppCategory &category, const int index) const;
     const ItemInfoList_v1 &windowedCategoryList();
     const ItemInfoList_v1 &windowedFrameItemInfoList();
     const ItemInfoList_v1 &fullscreenItemInfoList();
@@ -152,12 +149,16 @@ public slots:
 
     bool appIsNewInstall(const QString &key);
     bool appIsAutoStart(const QString &desktop);
-    bool appIsOnDock(const QString &desktop);
-    bool appIsOnDesktop(const QString &desktop);
-    bool appIsProxy(const QString &desktop);
-    bool appIsEnableScaling(const QString &desktop);
+    bool appIsOnDock(const ItemInfo_v1 &info);
+    bool appIsOnDesktop(const ItemInfo_v1 &info);
+    bool appIsProxy(const ItemInfo_v1 &info);
+    bool appIsEnableScaling(const ItemInfo_v1 &info);
+    void updateAppStatus(const QString &desktop, const AppStatusTable::Field field, const bool value);
+    void prefetchAppStatus();
     const QPixmap appIcon(const ItemInfo_v1 &info, const int size = 0);
+    const QPixmap syncAppIcon(const ItemInfo_v1 &info, const int size = 0);
     const QString appName(const ItemInfo_v1 &info, const int size);
+    const QString appDisplayName(const ItemInfo_v1 &info) const;
     int appNums(const AppsListModel::AppCategory &category);
 
     // 为顺应数据应用数据结构的变动以及兼容性考虑, 对　handleItemChanged 接口进行了重载．
@@ -177,7 +178,6 @@ private:
     void loadDefaultFavoriteList(const ItemInfoList_v1 &processList);
     void sortByGeneralOrder(ItemInfoList_v1 &processList);
     ItemInfoList_v1 sortByLetterOrder(ItemInfoList_v1 &processList);
-    void sortByPinyinOrder(ItemInfoList_v1 &processList);
     void sortByInstallTimeOrder(ItemInfoList_v1 &processList);
     void removeNonexistentData();
     void getCategoryListAndSortCategoryId();
@@ -188,19 +188,28 @@ private:
     void generateTitleCategoryList();
     void generateLetterCategoryList();
     void readCollectedCacheData();
+    void migrateLegacySortedLists();
+    void hydrateSortedList(ItemInfoList_v1 &list) const;
+    void applyItemChange(const QString &operation, const ItemInfo_v1 &info);
+    void insertApp(const ItemInfo_v1 &info);
+    void updateApp(const ItemInfo_v1 &info);
+    void removeApp(const QString &desktop);
     void refreshAppAutoStartCache(const QString &type = QString(), const QString &desktpFilePath = QString());
+    const QPixmap placeholderIcon(const int size);
 
-    void setAutostartValue(const QStringList &list);
-    QStringList getAutostartValue() const;
+    void loadAutostartCache();
+    void saveAutostartCache();
+    void scheduleSaveAutostartCache();
 
 private slots:
     void markLaunched(const QString &appKey);
     void delayRefreshData();
-    void refreshIcon();
+    void onIconRendered(const QString &desktop);
     void updateTrashState();
     bool fuzzyMatching(const QStringList& list, const QString& key);
     void onRefreshCalendarTimer();
     void onGSettingChanged(const QString & keyName);
+    void refreshGroupLists();
 
 public:
     QHash<AppsListModel::AppCategory, ItemInfoList_v1> m_appInfos;      // 应用分类容器
@@ -217,9 +226,11 @@ private:
     DBusStartManager *m_startManagerInter;
     AMDBusLauncherInter *m_amDbusLauncherInter;
     AMDBusDockInter *m_amDbusDockInter;
+    AppStatusTable *m_appStatusTable;                                       // 右键菜单使用的应用状态
 
     QString m_searchText;
     ItemInfoList_v1 m_allAppInfoList;                                       // 所有app信息列表
+    AppRegistry m_appRegistry;                                              // 所有app信息列表的索引
     QStringList m_newInstalledAppsList;                                     // 新安装应用列表
 
     ItemInfoList_v1 m_stashList;
@@ -227,34 +238,31 @@ private:
     ItemInfo_v1 m_beDragedItem;
 
     CalculateUtil *m_calUtil;
-    QTimer *m_delayRefreshTimer;                                            // 延迟刷新应用列表定时器指针对象
     QTimer *m_refreshCalendarIconTimer;
 
     QDate m_curDate;
     int m_lastShowDate;
 
-    int m_tryNums;                                                          // 获取应用图标时尝试的次数
-    int m_tryCount;                                                         // 超过10次停止遍历
-    ItemInfo_v1 m_itemInfo;                                                 // 当前需要更新的应用信息
-
     static QPointer<AppsManager> INSTANCE;
     static QGSettings *m_launcherSettings;
-    static QSet<QString> APP_AUTOSTART_CACHE;
+    static QSet<QString> APP_AUTOSTART_CACHE;                               // 自启动应用的desktop全路径
     static QSettings APP_USER_SORTED_LIST;
     static QSettings APP_USED_SORTED_LIST;
     static QSettings APP_CATEGORY_USED_SORTED_LIST;
 
-    QSettings *m_collectedSetting;
-    QSettings *m_categorySetting;
-    QSettings *m_fullscreenUsedSortSetting;
-    QSettings *m_windowedUsedSortSetting;
+    SortedListStore *m_collectedStore;
+    SortedListStore *m_categoryStore;
+    SortedListStore *m_fullscreenUsedSortStore;
+    SortedListStore *m_windowedUsedSortStore;
     QSettings *m_autostartDesktopListSetting;
+    QTimer *m_saveAutostartTimer;
+    bool m_autostartListLoading;                                            // AutostartList 的查询尚未返回
+    QHash<QString, bool> m_pendingAutostartChanges;                         // 查询返回前收到的自启动变化, desktop -> 是否自启动
+    QTimer *m_refreshGroupListsTimer;                                       // 合并连续的应用变化, 延迟重新生成标题及字母模式列表
 
     QStringList m_categoryTs;
     QGSettings *m_filterSetting;
 
-    bool m_iconValid;                                                       // 获取图标状态标示
-
     bool m_trashIsEmpty;
     QFileSystemWatcher *m_fsWatcher;
 
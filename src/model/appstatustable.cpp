@@ -0,0 +1,184 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appstatustable.h"
+#include "amdbuslauncherinterface.h"
+#include "amdbusdockinterface.h"
+
+#include <QDBusPendingCallWatcher>
+#include <QSet>
+
+/**
+ * @brief dockedAppId 任务栏驻留列表中的项可能是desktop全路径或带前缀的应用id, 统一为不带后缀的desktop文件名再比较
+ * @param desktop desktop全路径或驻留列表中的项
+ * @return desktop文件名, 不含.desktop后缀
+ */
+static QString dockedAppId(const QString &desktop)
+{
+    const QString suffix(".desktop");
+    QString id = desktop.section('/', -1).section('@', -1);
+    if (id.endsWith(suffix))
+        id.chop(suffix.size());
+
+    return id;
+}
+
+/**
+ * @brief defaultValue 状态查询失败时使用的默认值, 与原有同步调用失败时一致
+ */
+static bool defaultValue(const AppStatusTable::Field field)
+{
+    return field == AppStatusTable::EnableScaling;
+}
+
+AppStatusTable::AppStatusTable(AMDBusLauncherInter *launcherInter, AMDBusDockInter *dockInter, QObject *parent)
+    : QObject(parent)
+    , m_launcherInter(launcherInter)
+    , m_dockInter(dockInter)
+    , m_serial(0)
+{
+    connect(m_dockInter, &AMDBusDockInter::DockedAppsChanged, this, &AppStatusTable::onDockedAppsChanged);
+    connect(m_launcherInter, &AMDBusLauncherInter::SendToDesktopSuccess, this, &AppStatusTable::onSendToDesktopSuccess);
+    connect(m_launcherInter, &AMDBusLauncherInter::RemoveFromDesktopSuccess, this, &AppStatusTable::onRemoveFromDesktopSuccess);
+}
+
+/**
+ * @brief AppStatusTable::prefetch 异步查询列表中尚未缓存的应用状态, 已缓存的状态由变化信号保持更新, 不重复查询
+ * @param list 应用列表
+ */
+void AppStatusTable::prefetch(const ItemInfoList_v1 &list)
+{
+    for (const ItemInfo_v1 &info : list) {
+        if (info.m_desktop.isEmpty())
+            continue;
+
+        Entry &entry = m_entries[info.m_desktop];
+        entry.key = info.m_key;
+        for (int field = 0; field < FieldCount; ++field) {
+            if (!entry.loaded[field] && !entry.serials[field])
+                query(info.m_desktop, entry, Field(field));
+        }
+    }
+}
+
+/**
+ * @brief AppStatusTable::value 获取应用的状态, 未缓存时发出异步查询并先返回默认值, 不阻塞界面
+ * @param info 应用信息
+ * @param field 状态类型
+ * @return 已缓存的状态值, 未缓存时返回默认值
+ */
+bool AppStatusTable::value(const ItemInfo_v1 &info, const Field field)
+{
+    Entry &entry = m_entries[info.m_desktop];
+    entry.key = info.m_key;
+    if (entry.loaded[field])
+        return entry.values[field];
+
+    if (!entry.serials[field])
+        query(info.m_desktop, entry, field);
+
+    return defaultValue(field);
+}
+
+/**
+ * @brief AppStatusTable::setValue 菜单操作后直接更新状态, 服务没有对应的变化信号时使用
+ * @param desktop 应用的desktop全路径
+ * @param field 状态类型
+ * @param value 新的状态值
+ */
+void AppStatusTable::setValue(const QString &desktop, const Field field, const bool value)
+{
+    auto it = m_entries.find(desktop);
+    if (it == m_entries.end())
+        return;
+
+    it->serials[field] = 0;
+    it->loaded[field] = true;
+    it->values[field] = value;
+}
+
+void AppStatusTable::remove(const QString &desktop)
+{
+    m_entries.remove(desktop);
+}
+
+/**
+ * @brief AppStatusTable::onDockedAppsChanged 按信号携带的驻留列表直接更新各应用的驻留状态, 不再逐个查询
+ * @param dockedApps 任务栏驻留的应用列表
+ */
+void AppStatusTable::onDockedAppsChanged(const QStringList &dockedApps)
+{
+    QSet<QString> dockedIds;
+    for (const QString &app : dockedApps)
+        dockedIds.insert(dockedAppId(app));
+
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        // 忽略之前发出的查询, 以信号中的列表为准
+        it->serials[OnDock] = 0;
+        it->loaded[OnDock] = true;
+        it->values[OnDock] = dockedIds.contains(dockedAppId(it.key()));
+    }
+}
+
+void AppStatusTable::onSendToDesktopSuccess(const QString &key)
+{
+    setKeyValue(key, OnDesktop, true);
+}
+
+void AppStatusTable::onRemoveFromDesktopSuccess(const QString &key)
+{
+    setKeyValue(key, OnDesktop, false);
+}
+
+QDBusPendingCall AppStatusTable::call(const QString &desktop, const QString &key, const Field field) const
+{
+    switch (field) {
+    case OnDesktop:
+        return m_launcherInter->IsItemOnDesktop(key);
+    case OnDock:
+        return m_dockInter->IsDocked(desktop);
+    case UseProxy:
+        return m_launcherInter->GetUseProxy(key);
+    default:
+        return m_launcherInter->GetDisableScaling(key);
+    }
+}
+
+/**
+ * @brief AppStatusTable::query 发出异步查询, 只采用同一状态最后一次查询的结果
+ */
+void AppStatusTable::query(const QString &desktop, Entry &entry, const Field field)
+{
+    const quint64 serial = ++m_serial;
+    entry.serials[field] = serial;
+
+    QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(call(desktop, entry.key, field), this);
+    connect(watcher, &QDBusPendingCallWatcher::finished, this, [ this, desktop, field, serial ](QDBusPendingCallWatcher *w) {
+        w->deleteLater();
+
+        auto it = m_entries.find(desktop);
+        if (it == m_entries.end() || it->serials[field] != serial)
+            return;
+
+        it->serials[field] = 0;
+        it->loaded[field] = true;
+
+        // 查询失败时缓存默认值, 避免每次打开菜单都重新查询, 之后由变化信号及菜单操作更新
+        const QDBusPendingReply<bool> reply = *w;
+        if (reply.isError()) {
+            it->values[field] = defaultValue(field);
+            return;
+        }
+
+        it->values[field] = (field == EnableScaling) ? !reply.value() : reply.value();
+    });
+}
+
+void AppStatusTable::setKeyValue(const QString &key, const Field field, const bool value)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->key == key)
+            setValue(it.key(), field, value);
+    }
+}
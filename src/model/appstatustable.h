@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPSTATUSTABLE_H
+#define APPSTATUSTABLE_H
+
+#include "iteminfo.h"
+
+#include <QObject>
+#include <QHash>
+
+class AMDBusLauncherInter;
+class AMDBusDockInter;
+class QDBusPendingCall;
+
+/**应用状态表
+ * 缓存右键菜单需要的各应用是否在桌面、是否驻留任务栏、是否使用代理及是否允许缩放等状态
+ * 启动器显示时异步批量查询尚未缓存的应用, 之后由服务的变化信号及菜单操作更新, 打开右键菜单时不再同步调用 D-Bus
+ * 查询结果返回前读取的状态先返回默认值, 不会同步等待 D-Bus 返回
+ * @brief The AppStatusTable class
+ */
+class AppStatusTable : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Field {
+        OnDesktop,
+        OnDock,
+        UseProxy,
+        EnableScaling,
+        FieldCount
+    };
+
+    explicit AppStatusTable(AMDBusLauncherInter *launcherInter, AMDBusDockInter *dockInter, QObject *parent = nullptr);
+
+    void prefetch(const ItemInfoList_v1 &list);
+    bool value(const ItemInfo_v1 &info, const Field field);
+    void setValue(const QString &desktop, const Field field, const bool value);
+    void remove(const QString &desktop);
+
+private slots:
+    void onDockedAppsChanged(const QStringList &dockedApps);
+    void onSendToDesktopSuccess(const QString &key);
+    void onRemoveFromDesktopSuccess(const QString &key);
+
+private:
+    struct Entry {
+        QString key;
+        bool loaded[FieldCount] = {};
+        bool values[FieldCount] = {};
+        quint64 serials[FieldCount] = {};      // 未返回的查询的序号, 为0时表示没有正在进行的查询
+    };
+
+    QDBusPendingCall call(const QString &desktop, const QString &key, const Field field) const;
+    void query(const QString &desktop, Entry &entry, const Field field);
+    void setKeyValue(const QString &key, const Field field, const bool value);
+
+private:
+    AMDBusLauncherInter *m_launcherInter;
+    AMDBusDockInter *m_dockInter;
+
+    QHash<QString, Entry> m_entries;            // desktop -> 状态
+    quint64 m_serial;
+};
+
+#endif // APPSTATUSTABLE_H
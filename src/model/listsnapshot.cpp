@@ -0,0 +1,289 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "listsnapshot.h"
+
+#include <QVector>
+
+#include <cstring>
+
+namespace {
+
+const char SNAPSHOT_MAGIC[4] = { 'D', 'L', 'S', 'S' };
+const quint16 BYTE_ORDER_MARK = 0x0102;         // 按本机字节序写入, 读取时不一致则视为无效
+
+struct Header {
+    char magic[4];
+    quint16 version;
+    quint16 byteOrder;
+    quint32 checksum;                           // 文件头之后所有数据的 CRC32
+    quint32 listCount;
+    quint32 recordCount;
+    quint32 stringCount;
+    quint32 stringDataSize;                     // 字符串数据的字节数
+    quint32 reserved;
+};
+
+struct ListEntry {
+    quint32 name;                               // 列表键值在字符串表中的序号
+    quint32 firstRecord;
+    quint32 recordCount;
+};
+
+struct Record {
+    qint64 openCount;
+    qint64 firstRunTime;
+    quint32 desktop;                            // 字符串表中的序号
+    quint32 name;                               // 文件夹名称在字符串表中的序号, 应用的名称不保存
+    quint32 firstChild;                         // 文件夹内的应用记录, 位于所有列表的记录之后
+    quint32 childCount;
+    quint32 isDir;
+    quint32 reserved;
+};
+
+struct StringEntry {
+    quint32 offset;                             // 在字符串数据中的位置(UTF-16 字符数)
+    quint32 length;
+};
+
+static_assert(sizeof(Header) == 32, "unexpected snapshot header size");
+static_assert(sizeof(ListEntry) == 12, "unexpected snapshot list entry size");
+static_assert(sizeof(Record) == 40, "unexpected snapshot record size");
+static_assert(sizeof(StringEntry) == 8, "unexpected snapshot string entry size");
+
+class StringTable
+{
+public:
+    quint32 add(const QString &str)
+    {
+        auto it = m_indexes.constFind(str);
+        if (it != m_indexes.constEnd())
+            return it.value();
+
+        const quint32 index = quint32(m_entries.size());
+        m_entries.append({ quint32(m_data.size()), quint32(str.size()) });
+        m_data.append(str);
+        m_indexes.insert(str, index);
+        return index;
+    }
+
+    const QVector<StringEntry> &entries() const { return m_entries; }
+    const QString &data() const { return m_data; }
+
+private:
+    QHash<QString, quint32> m_indexes;
+    QVector<StringEntry> m_entries;
+    QString m_data;
+};
+
+Record makeRecord(const ItemInfo_v1 &info, StringTable &strings)
+{
+    Record record;
+    std::memset(&record, 0, sizeof(record));
+
+    record.openCount = info.m_openCount;
+    record.firstRunTime = info.m_firstRunTime;
+    record.desktop = strings.add(info.m_desktop);
+    record.name = strings.add(info.m_isDir ? info.m_name : QString());
+    record.isDir = info.m_isDir;
+
+    return record;
+}
+
+template <typename T>
+void appendRaw(QByteArray &out, const T *items, const int count)
+{
+    out.append(reinterpret_cast<const char *>(items), int(sizeof(T)) * count);
+}
+
+template <typename T>
+T readRaw(const uchar *data, const qint64 index)
+{
+    // 映射的文件不保证对齐, 复制后再读取
+    T item;
+    std::memcpy(&item, data + index * qint64(sizeof(T)), sizeof(T));
+    return item;
+}
+
+} // namespace
+
+/**
+ * @brief ListSnapshot::encode 生成快照
+ * @param lists 键值 -> 应用列表
+ * @return 快照数据
+ */
+QByteArray ListSnapshot::encode(const Lists &lists)
+{
+    StringTable strings;
+    QVector<ListEntry> listEntries;
+    QVector<Record> records;
+
+    // 按键值排序, 内容相同时生成的快照也相同
+    QStringList keys = lists.keys();
+    keys.sort();
+
+    for (const QString &key : keys) {
+        const ItemInfoList_v1 list = lists.value(key);
+        listEntries.append({ strings.add(key), quint32(records.size()), quint32(list.size()) });
+
+        for (const ItemInfo_v1 &info : list)
+            records.append(makeRecord(info, strings));
+    }
+
+    // 文件夹内的应用追加在所有列表的记录之后
+    int row = 0;
+    for (const QString &key : keys) {
+        const ItemInfoList_v1 list = lists.value(key);
+        for (const ItemInfo_v1 &info : list) {
+            const int current = row++;
+            if (info.m_appInfoList.isEmpty())
+                continue;
+
+            records[current].firstChild = quint32(records.size());
+            records[current].childCount = quint32(info.m_appInfoList.size());
+            for (const ItemInfo_v1 &child : info.m_appInfoList)
+                records.append(makeRecord(child, strings));
+        }
+    }
+
+    QByteArray body;
+    appendRaw(body, listEntries.constData(), listEntries.size());
+    appendRaw(body, records.constData(), records.size());
+    appendRaw(body, strings.entries().constData(), strings.entries().size());
+    appendRaw(body, strings.data().utf16(), strings.data().size());
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = Version;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.checksum = checksum(reinterpret_cast<const uchar *>(body.constData()), body.size());
+    header.listCount = quint32(listEntries.size());
+    header.recordCount = quint32(records.size());
+    header.stringCount = quint32(strings.entries().size());
+    header.stringDataSize = quint32(strings.data().size() * int(sizeof(ushort)));
+
+    QByteArray out;
+    out.reserve(int(sizeof(header)) + body.size());
+    appendRaw(out, &header, 1);
+    out.append(body);
+
+    return out;
+}
+
+/**
+ * @brief ListSnapshot::decode 读取快照, 任何校验失败都不修改 lists
+ * @param data 快照数据, 可以是映射到内存的文件
+ * @param size 数据长度
+ * @param lists 读取到的列表
+ * @return 快照有效时返回 true
+ */
+bool ListSnapshot::decode(const uchar *data, const qint64 size, Lists &lists)
+{
+    if (!data || size < qint64(sizeof(Header)))
+        return false;
+
+    const Header header = readRaw<Header>(data, 0);
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0
+            || header.version != Version || header.byteOrder != BYTE_ORDER_MARK
+            || header.stringDataSize % sizeof(ushort) != 0)
+        return false;
+
+    const qint64 listOffset = sizeof(Header);
+    const qint64 recordOffset = listOffset + qint64(header.listCount) * qint64(sizeof(ListEntry));
+    const qint64 stringEntryOffset = recordOffset + qint64(header.recordCount) * qint64(sizeof(Record));
+    const qint64 stringDataOffset = stringEntryOffset + qint64(header.stringCount) * qint64(sizeof(StringEntry));
+    if (stringDataOffset + qint64(header.stringDataSize) != size)
+        return false;
+
+    if (checksum(data + sizeof(Header), size - qint64(sizeof(Header))) != header.checksum)
+        return false;
+
+    // 字符串只构造一次, 各应用信息共享
+    const quint32 stringDataLength = header.stringDataSize / sizeof(ushort);
+    QVector<QString> strings;
+    strings.reserve(int(header.stringCount));
+    for (quint32 i = 0; i < header.stringCount; ++i) {
+        const StringEntry entry = readRaw<StringEntry>(data + stringEntryOffset, i);
+        if (quint64(entry.offset) + entry.length > stringDataLength)
+            return false;
+
+        QString str(int(entry.length), Qt::Uninitialized);
+        std::memcpy(str.data(), data + stringDataOffset + qint64(entry.offset) * qint64(sizeof(ushort)), entry.length * sizeof(ushort));
+        strings.append(str);
+    }
+
+    bool valid = true;
+    auto string = [ & ](const quint32 index) {
+        if (index >= quint32(strings.size())) {
+            valid = false;
+            return QString();
+        }
+
+        return strings.at(int(index));
+    };
+
+    auto itemInfo = [ & ](const Record &record) {
+        ItemInfo_v1 info;
+        info.m_desktop = string(record.desktop);
+        info.m_name = string(record.name);
+        info.m_openCount = record.openCount;
+        info.m_firstRunTime = record.firstRunTime;
+        info.m_isDir = record.isDir;
+        return info;
+    };
+
+    Lists result;
+    for (quint32 i = 0; i < header.listCount && valid; ++i) {
+        const ListEntry entry = readRaw<ListEntry>(data + listOffset, i);
+        if (quint64(entry.firstRecord) + entry.recordCount > header.recordCount)
+            return false;
+
+        ItemInfoList_v1 list;
+        list.reserve(int(entry.recordCount));
+        for (quint32 row = entry.firstRecord; row < entry.firstRecord + entry.recordCount; ++row) {
+            const Record record = readRaw<Record>(data + recordOffset, row);
+            ItemInfo_v1 info = itemInfo(record);
+
+            if (quint64(record.firstChild) + record.childCount > header.recordCount)
+                return false;
+
+            for (quint32 child = record.firstChild; child < record.firstChild + record.childCount; ++child)
+                info.m_appInfoList.append(itemInfo(readRaw<Record>(data + recordOffset, child)));
+
+            list.append(info);
+        }
+
+        result.insert(string(entry.name), list);
+    }
+
+    if (!valid)
+        return false;
+
+    lists.swap(result);
+    return true;
+}
+
+/**
+ * @brief ListSnapshot::checksum 计算 CRC32 (IEEE 802.3)
+ */
+quint32 ListSnapshot::checksum(const uchar *data, const qint64 size)
+{
+    static const QVector<quint32> table = [] {
+        QVector<quint32> crcTable(256);
+        for (quint32 i = 0; i < 256; ++i) {
+            quint32 crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            crcTable[int(i)] = crc;
+        }
+        return crcTable;
+    }();
+
+    quint32 crc = 0xFFFFFFFFu;
+    for (qint64 i = 0; i < size; ++i)
+        crc = table.at(int((crc ^ data[i]) & 0xFF)) ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFFu;
+}
@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef LISTSNAPSHOT_H
+#define LISTSNAPSHOT_H
+
+#include "iteminfo.h"
+
+#include <QByteArray>
+#include <QHash>
+
+/**应用排序列表的二进制快照
+ * 文件依次为: 文件头、列表表、定长的应用记录、字符串索引表、UTF-16 字符串数据
+ * 各部分的位置由文件头中的数量直接算出, 可以映射到内存后按偏移读取, 不需要逐个字段解析
+ * 字符串去重后只存储一次, 文件头记录版本号、字节序及文件头之后所有数据的 CRC32 校验值
+ * 记录只保存 desktop、文件夹名称、文件夹内的应用及使用次数, 应用的其他信息读取后从 AppsManager 的应用列表中补全
+ * @brief The ListSnapshot class
+ */
+class ListSnapshot
+{
+public:
+    enum { Version = 2 };
+
+    typedef QHash<QString, ItemInfoList_v1> Lists;
+
+    static QByteArray encode(const Lists &lists);
+    static bool decode(const uchar *data, const qint64 size, Lists &lists);
+    static quint32 checksum(const uchar *data, const qint64 size);
+};
+
+#endif // LISTSNAPSHOT_H
@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sortedliststore.h"
+#include "listsnapshot.h"
+#include "constants.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent>
+
+/**
+ * @brief SortedListStore::SortedListStore
+ * @param name 缓存文件名称(不含扩展名), 快照与原 json 文件位于同一目录
+ */
+SortedListStore::SortedListStore(const QString &name, QObject *parent)
+    : QObject(parent)
+    , m_fileName(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + QString("/deepin/%1.snapshot").arg(name))
+    , m_jsonFileName(QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + QString("/deepin/%1.json").arg(name))
+    , m_saveTimer(new QTimer(this))
+    , m_writeThreadPool(new QThreadPool(this))
+{
+    m_writeThreadPool->setMaxThreadCount(1);
+
+    m_saveTimer->setSingleShot(true);
+    m_saveTimer->setInterval(DLauncher::LIST_SAVE_DELAY_TIME);
+
+    connect(m_saveTimer, &QTimer::timeout, this, &SortedListStore::save);
+    connect(qApp, &QCoreApplication::aboutToQuit, this, &SortedListStore::flush);
+
+    load();
+}
+
+SortedListStore::~SortedListStore()
+{
+    flush();
+}
+
+QString SortedListStore::fileName() const
+{
+    return m_fileName;
+}
+
+QString SortedListStore::jsonFileName() const
+{
+    return m_jsonFileName;
+}
+
+bool SortedListStore::contains(const QString &key) const
+{
+    return m_lists.contains(key);
+}
+
+ItemInfoList_v1 SortedListStore::value(const QString &key) const
+{
+    return m_lists.value(key);
+}
+
+/**
+ * @brief SortedListStore::setValue 更新内存中的列表, 空闲一段时间后写入文件
+ * @param key 列表的键值
+ * @param list 应用列表
+ */
+void SortedListStore::setValue(const QString &key, const ItemInfoList_v1 &list)
+{
+    m_lists.insert(key, list);
+    m_saveTimer->start();
+}
+
+/**
+ * @brief SortedListStore::flush 立即写入尚未保存的修改, 并等待写入完成
+ */
+void SortedListStore::flush()
+{
+    if (m_saveTimer->isActive()) {
+        m_saveTimer->stop();
+        save();
+    }
+
+    m_writeThreadPool->waitForDone();
+}
+
+QVariantMap SortedListStore::toVariantMap(const ItemInfoList_v1 &list)
+{
+    // 与快照一致, 只保存 desktop、文件夹名称及使用次数, 应用的其他信息读取后从应用列表中补全
+    auto fillMapData = [ & ](QVariantMap &map, const ItemInfo_v1 &info) {
+        map.insert("desktop", info.m_desktop);
+        if (info.m_isDir)
+            map.insert("appName", info.m_name);
+        map.insert("openCount", info.m_openCount);
+        map.insert("firstRunTime", info.m_firstRunTime);
+        map.insert("isDir", info.m_isDir);
+    };
+
+    QVariantMap map;
+    for (int i = 0; i < list.size(); i++) {
+        QVariantMap itemMap, itemDirMap;
+        const ItemInfo_v1 &info = list.at(i);
+        fillMapData(itemMap, info);
+
+        for (int j = 0; j < info.m_appInfoList.size(); j++) {
+            const ItemInfo_v1 &dirInfo = info.m_appInfoList.at(j);
+            fillMapData(itemDirMap, dirInfo);
+            itemMap.insert(QString("appInfoList_%1").arg(j), itemDirMap);
+        }
+        if (info.m_isDir)
+            itemMap.insert("appInfoSize", info.m_appInfoList.size());
+
+        map.insert(QString("itemInfoList_%1").arg(i), itemMap);
+    }
+
+    return map;
+}
+
+ItemInfoList_v1 SortedListStore::fromVariantMap(const QVariantMap &map)
+{
+    auto getMapData = [ & ](ItemInfo_v1 &info, const QVariantMap &infoMap) {
+        info.m_desktop = infoMap.value("desktop").toString();
+        info.m_name = infoMap.value("appName").toString();
+        info.m_key = infoMap.value("appKey").toString();
+        info.m_iconKey = infoMap.value("iconKey").toString();
+        info.m_status = infoMap.value("appStatus").toInt();
+        info.m_categoryId = infoMap.value("categoryId").toLongLong();
+        info.m_description = infoMap.value("description").toString();
+        info.m_progressValue = infoMap.value("progressValue").toInt();
+        info.m_installedTime = infoMap.value("installTime").toInt();
+        info.m_openCount = infoMap.value("openCount").toLongLong();
+        info.m_firstRunTime = infoMap.value("firstRunTime").toLongLong();
+        info.m_isDir = infoMap.value("isDir").toLongLong();
+    };
+
+    ItemInfoList_v1 infoList;
+    for (int i = 0; i < map.size(); i++) {
+        ItemInfo_v1 info;
+        ItemInfoList_v1 appList;
+        QVariantMap itemInfoMap = map.value(QString("itemInfoList_%1").arg(i)).toMap();
+
+        getMapData(info, itemInfoMap);
+        int appInfoSize = itemInfoMap.contains("appInfoSize") ? itemInfoMap.value("appInfoSize").toInt() : 0;
+
+        ItemInfo_v1 appInfo;
+        for (int j = 0; j < appInfoSize; j++) {
+            QVariantMap appInfoMap = itemInfoMap.value(QString("appInfoList_%1").arg(j)).toMap();
+            getMapData(appInfo, appInfoMap);
+            appList.append(appInfo);
+        }
+        info.m_appInfoList.append(appList);
+        infoList.append(info);
+    }
+
+    return infoList;
+}
+
+/**
+ * @brief SortedListStore::importJson 从 json 文件导入列表, 替换内存中的所有列表并写入快照
+ * @param fileName json 文件路径
+ * @return 导入成功时返回 true
+ */
+bool SortedListStore::importJson(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QJsonParseError jsonParser;
+    const QVariantMap map = QJsonDocument::fromJson(file.readAll(), &jsonParser).toVariant().toMap();
+    if (jsonParser.error != QJsonParseError::NoError) {
+        qWarning() << "parse sorted list failed:" << fileName << jsonParser.errorString();
+        return false;
+    }
+
+    m_lists.clear();
+    for (auto it = map.constBegin(); it != map.constEnd(); ++it)
+        m_lists.insert(it.key(), fromVariantMap(it.value().toMap()));
+
+    m_saveTimer->start();
+    return true;
+}
+
+/**
+ * @brief SortedListStore::exportJson 以原有的 json 格式导出所有列表
+ * @param fileName json 文件路径
+ * @return 导出成功时返回 true
+ */
+bool SortedListStore::exportJson(const QString &fileName) const
+{
+    QVariantMap map;
+    for (auto it = m_lists.constBegin(); it != m_lists.constEnd(); ++it)
+        map.insert(it.key(), toVariantMap(it.value()));
+
+    return write(fileName, QJsonDocument::fromVariant(map).toJson());
+}
+
+/**
+ * @brief SortedListStore::load 映射快照文件后一次读取, 快照不存在或无效时导入 json 文件
+ */
+void SortedListStore::load()
+{
+    QFile file(m_fileName);
+    if (file.open(QIODevice::ReadOnly)) {
+        const qint64 size = file.size();
+        const uchar *data = file.map(0, size);
+        const bool loaded = ListSnapshot::decode(data, size, m_lists);
+        if (data)
+            file.unmap(const_cast<uchar *>(data));
+
+        if (loaded)
+            return;
+
+        qWarning() << "invalid sorted list snapshot:" << m_fileName;
+    }
+
+    importJson(m_jsonFileName);
+}
+
+/**
+ * @brief SortedListStore::save 复制当前的列表(隐式共享, 不复制数据)交给后台线程生成快照并写入
+ */
+void SortedListStore::save()
+{
+    const QString fileName = m_fileName;
+    const ListSnapshot::Lists lists = m_lists;
+
+    QtConcurrent::run(m_writeThreadPool, [ fileName, lists ] {
+        if (!write(fileName, ListSnapshot::encode(lists)))
+            qWarning() << "save sorted list failed:" << fileName;
+    });
+}
+
+bool SortedListStore::write(const QString &fileName, const QByteArray &data)
+{
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        return false;
+    }
+
+    return file.commit();
+}
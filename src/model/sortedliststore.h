@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SORTEDLISTSTORE_H
+#define SORTEDLISTSTORE_H
+
+#include "iteminfo.h"
+
+#include <QObject>
+#include <QHash>
+#include <QVariantMap>
+
+class QTimer;
+class QThreadPool;
+
+/**应用排序列表的缓存文件
+ * 以 ListSnapshot 二进制快照保存, 启动时映射文件后一次读取; 没有快照时从原有的 json 文件导入
+ * 读取时一次性加载到内存, 修改只更新内存中的列表并延迟写入, 短时间内的多次修改合并为一次写入
+ * 写入在后台线程中完成, 先写临时文件再替换, 程序退出时写入尚未保存的修改
+ * @brief The SortedListStore class
+ */
+class SortedListStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit SortedListStore(const QString &name, QObject *parent = nullptr);
+    ~SortedListStore() override;
+
+    QString fileName() const;
+    QString jsonFileName() const;
+    bool contains(const QString &key) const;
+    ItemInfoList_v1 value(const QString &key) const;
+    void setValue(const QString &key, const ItemInfoList_v1 &list);
+    void flush();
+
+    bool importJson(const QString &fileName);
+    bool exportJson(const QString &fileName) const;
+
+    static QVariantMap toVariantMap(const ItemInfoList_v1 &list);
+    static ItemInfoList_v1 fromVariantMap(const QVariantMap &map);
+
+private:
+    void load();
+    void save();
+    static bool write(const QString &fileName, const QByteArray &data);
+
+private:
+    QString m_fileName;
+    QString m_jsonFileName;
+    QHash<QString, ItemInfoList_v1> m_lists;
+    QTimer *m_saveTimer;
+    QThreadPool *m_writeThreadPool;                     // 单线程, 保证同一文件按修改顺序写入
+};
+
+#endif // SORTEDLISTSTORE_H
@@ -4,29 +4,217 @@
 
 #include "sortfilterproxymodel.h"
 #include "appslistmodel.h"
+#include "appsearchindex.h"
+#include "constants.h"
 #include "iteminfo.h"
-#include "languagetranformation.h"
 
 #include <QDebug>
 
+#include <algorithm>
+
 SortFilterProxyModel::SortFilterProxyModel(QObject *parent)
     : QSortFilterProxyModel (parent)
-    , m_languageSwitch(LanguageTransformation::instance())
+    , m_searchIndex(AppSearchIndex::instance())
+    , m_hitsValid(false)
+{
+}
+
+void SortFilterProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
+{
+    if (this->sourceModel())
+        disconnect(this->sourceModel(), nullptr, this, nullptr);
+
+    QSortFilterProxyModel::setSourceModel(sourceModel);
+    m_hitsValid = false;
+
+    if (!sourceModel)
+        return;
+
+    // 搜索结果按匹配分数排序
+    sort(0);
+
+    // 源模型的行发生变化后, 记录的行号不再可靠, 重新遍历
+    connect(sourceModel, &QAbstractItemModel::modelReset, this, &SortFilterProxyModel::onSourceModelChanged);
+    connect(sourceModel, &QAbstractItemModel::layoutChanged, this, &SortFilterProxyModel::onSourceModelChanged);
+    connect(sourceModel, &QAbstractItemModel::rowsInserted, this, &SortFilterProxyModel::onSourceModelChanged);
+    connect(sourceModel, &QAbstractItemModel::rowsRemoved, this, &SortFilterProxyModel::onSourceModelChanged);
+    connect(sourceModel, &QAbstractItemModel::rowsMoved, this, &SortFilterProxyModel::onSourceModelChanged);
+
+    // 应用名称等信息变化后, 重新计算对应行的分数
+    connect(sourceModel, &QAbstractItemModel::dataChanged, this, &SortFilterProxyModel::onSourceDataChanged);
+}
+
+/**
+ * @brief SortFilterProxyModel::setSearchText 设置搜索内容并更新搜索结果
+ * @param text 搜索内容
+ */
+void SortFilterProxyModel::setSearchText(const QString &text)
+{
+    const QString searchText = text.toLower();
+    if (m_hitsValid && searchText == m_searchText)
+        return;
+
+    // 在上一次的内容后追加字符时, 结果是上一次结果的子集, 只在上一次的结果中筛选
+    const bool narrowing = m_hitsValid && AppSearchIndex::isNarrowing(m_searchText, searchText);
+    m_searchText = searchText;
+
+    if (narrowing)
+        searchHitRows();
+    else
+        searchAllRows();
+
+    selectTopRows();
+    invalidate();
+}
+
+QString SortFilterProxyModel::searchText() const
 {
+    return m_searchText;
 }
 
 bool SortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-    QModelIndex modelIndex = this->sourceModel()->index(sourceRow, 0, sourceParent);
+    Q_UNUSED(sourceParent);
+
+    if (m_hitsValid && sourceRow < m_hitMask.size())
+        return m_hitMask.at(sourceRow);
+
+    return rowScore(sourceRow) > AppSearchIndex::NoMatch;
+}
+
+/**
+ * @brief SortFilterProxyModel::lessThan 分数高的排在前面, 分数相同时保持源模型中的顺序
+ */
+bool SortFilterProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    const int leftScore = m_rowScores.value(sourceLeft.row());
+    const int rightScore = m_rowScores.value(sourceRight.row());
+    if (leftScore != rightScore)
+        return leftScore > rightScore;
+
+    return sourceLeft.row() < sourceRight.row();
+}
+
+void SortFilterProxyModel::onSourceModelChanged()
+{
+    if (!m_hitsValid)
+        return;
+
+    searchAllRows();
+    selectTopRows();
+    invalidate();
+}
+
+/**
+ * @brief SortFilterProxyModel::onSourceDataChanged 只重新计算内容变化的行的分数, 分数变化时更新搜索结果
+ * 仅安装状态、进度等与搜索无关的数据变化时不处理
+ */
+void SortFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (!m_hitsValid || !topLeft.isValid() || !bottomRight.isValid())
+        return;
+
+    if (!roles.isEmpty() && !roles.contains(AppsListModel::AppNameRole) && !roles.contains(AppsListModel::AppRawItemInfoRole))
+        return;
+
+    bool changed = false;
+    const int lastRow = qMin(bottomRight.row(), m_rowScores.size() - 1);
+    for (int row = topLeft.row(); row <= lastRow; ++row) {
+        const int score = rowScore(row);
+        if (score == m_rowScores.at(row))
+            continue;
+
+        // 命中的行号保持升序
+        auto it = std::lower_bound(m_hitRows.begin(), m_hitRows.end(), row);
+        const bool wasHit = it != m_hitRows.end() && *it == row;
+        if (score == AppSearchIndex::NoMatch && wasHit)
+            m_hitRows.erase(it);
+        else if (score != AppSearchIndex::NoMatch && !wasHit)
+            m_hitRows.insert(it, row);
+
+        m_rowScores[row] = score;
+        changed = true;
+    }
+
+    if (!changed)
+        return;
+
+    selectTopRows();
+    invalidate();
+}
+
+/**
+ * @brief SortFilterProxyModel::rowScore 计算源模型中的应用与搜索内容的匹配分数
+ * @param sourceRow 源模型行号
+ * @return 匹配分数, 0 表示不匹配
+ */
+int SortFilterProxyModel::rowScore(int sourceRow) const
+{
+    const QModelIndex modelIndex = sourceModel()->index(sourceRow, 0);
+
+    // 优先使用预先生成的索引, 不在索引中的应用再临时生成搜索文本
+    const QString desktop = modelIndex.data(AppsListModel::AppDesktopRole).toString();
+    if (m_searchIndex->contains(desktop))
+        return m_searchIndex->score(desktop, m_searchText);
+
     const ItemInfo_v1 &info = modelIndex.data(AppsListModel::AppRawItemInfoRole).value<ItemInfo_v1>();
+    return m_searchIndex->score(info, m_searchText);
+}
+
+/**
+ * @brief SortFilterProxyModel::searchAllRows 遍历源模型的所有应用
+ */
+void SortFilterProxyModel::searchAllRows()
+{
+    const int rowCount = sourceModel() ? sourceModel()->rowCount() : 0;
+    m_hitRows.clear();
+    m_rowScores.fill(AppSearchIndex::NoMatch, rowCount);
+
+    for (int row = 0; row < rowCount; ++row) {
+        const int score = rowScore(row);
+        if (score == AppSearchIndex::NoMatch)
+            continue;
+
+        m_hitRows.append(row);
+        m_rowScores[row] = score;
+    }
+
+    m_hitsValid = sourceModel() != nullptr;
+}
+
+/**
+ * @brief SortFilterProxyModel::searchHitRows 只在上一次命中的应用中筛选
+ */
+void SortFilterProxyModel::searchHitRows()
+{
+    QVector<int> hitRows;
+    hitRows.reserve(m_hitRows.size());
+
+    for (const int row : m_hitRows) {
+        const int score = rowScore(row);
+        m_rowScores[row] = score;
+        if (score != AppSearchIndex::NoMatch)
+            hitRows.append(row);
+    }
+
+    m_hitRows.swap(hitRows);
+}
+
+/**
+ * @brief SortFilterProxyModel::selectTopRows 部分排序选出分数最高的前若干个应用
+ */
+void SortFilterProxyModel::selectTopRows()
+{
+    m_hitMask.fill(false, m_rowScores.size());
 
-    QString jianpinStr = m_languageSwitch->zhToJianPin(info.m_name);
-    QString pinyinStr = m_languageSwitch->zhToPinYin(info.m_name);
-    QString searchedText = filterRegExp().pattern();
+    QVector<int> rows = m_hitRows;
+    const int count = qMin(rows.size(), DLauncher::SEARCH_RESULT_MAX_COUNT);
+    std::partial_sort(rows.begin(), rows.begin() + count, rows.end(), [ this ](const int left, const int right) {
+        const int leftScore = m_rowScores.at(left);
+        const int rightScore = m_rowScores.at(right);
+        return leftScore != rightScore ? leftScore > rightScore : left < right;
+    });
 
-    return info.m_desktop.contains(searchedText, Qt::CaseInsensitive) ||
-           info.m_name.contains(searchedText, Qt::CaseInsensitive) ||
-           info.m_key.contains(searchedText, Qt::CaseInsensitive) ||
-           jianpinStr.contains(searchedText, Qt::CaseInsensitive) ||
-           pinyinStr.contains(searchedText, Qt::CaseInsensitive);
+    for (int i = 0; i < count; ++i)
+        m_hitMask[rows.at(i)] = true;
 }
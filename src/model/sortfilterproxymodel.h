@@ -7,20 +7,47 @@
 
 #include <QObject>
 #include <QSortFilterProxyModel>
-#include "languagetranformation.h"
+#include <QVector>
 
+class AppSearchIndex;
+
+/**搜索模式下的应用列表模型
+ * 输入内容在上一次搜索内容之后追加字符时, 只在上一次的搜索结果中继续筛选,
+ * 删除字符或修改中间内容时才重新遍历所有应用
+ * 只显示匹配分数最高的前若干个应用, 并按分数从高到低排序
+ * @brief The SortFilterProxyModel class
+ */
 class SortFilterProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
 public:
     SortFilterProxyModel(QObject *parent = Q_NULLPTR);
 
+    void setSourceModel(QAbstractItemModel *sourceModel) Q_DECL_OVERRIDE;
+    void setSearchText(const QString &text);
+    QString searchText() const;
+
 protected:
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const Q_DECL_OVERRIDE;
+    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const Q_DECL_OVERRIDE;
+
+private slots:
+    void onSourceModelChanged();
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+
+private:
+    int rowScore(int sourceRow) const;
+    void searchAllRows();
+    void searchHitRows();
+    void selectTopRows();
 
 private:
-    QString m_filterStr;
-    LanguageTransformation *m_languageSwitch;
+    AppSearchIndex *m_searchIndex;
+    QString m_searchText;                   // 小写的搜索内容
+    QVector<int> m_hitRows;                 // 命中的源模型行号, 按行号升序
+    QVector<int> m_rowScores;               // 按源模型行号记录匹配分数, 0 表示不匹配
+    QVector<bool> m_hitMask;                // 按源模型行号标记是否显示
+    bool m_hitsValid;                       // 源模型变化后, 命中结果失效, 需要重新遍历
 };
 
 #endif
@@ -908,6 +908,96 @@ void AppGridView::createMovingComponent()
     }
 }
 
+/**
+ * @brief AppGridView::setModel 设置模型, 模型数据变化后页面缓存失效
+ * @param model 视图的模型
+ */
+void AppGridView::setModel(QAbstractItemModel *model)
+{
+    if (QAbstractItemModel *oldModel = this->model()) {
+        disconnect(oldModel, &QAbstractItemModel::dataChanged, this, &AppGridView::clearPageCache);
+        disconnect(oldModel, &QAbstractItemModel::layoutChanged, this, &AppGridView::clearPageCache);
+        disconnect(oldModel, &QAbstractItemModel::modelReset, this, &AppGridView::clearPageCache);
+        disconnect(oldModel, &QAbstractItemModel::rowsInserted, this, &AppGridView::clearPageCache);
+        disconnect(oldModel, &QAbstractItemModel::rowsRemoved, this, &AppGridView::clearPageCache);
+        disconnect(oldModel, &QAbstractItemModel::rowsMoved, this, &AppGridView::clearPageCache);
+    }
+
+    QListView::setModel(model);
+    clearPageCache();
+
+    if (!model)
+        return;
+
+    connect(model, &QAbstractItemModel::dataChanged, this, &AppGridView::clearPageCache);
+    connect(model, &QAbstractItemModel::layoutChanged, this, &AppGridView::clearPageCache);
+    connect(model, &QAbstractItemModel::modelReset, this, &AppGridView::clearPageCache);
+    connect(model, &QAbstractItemModel::rowsInserted, this, &AppGridView::clearPageCache);
+    connect(model, &QAbstractItemModel::rowsRemoved, this, &AppGridView::clearPageCache);
+    connect(model, &QAbstractItemModel::rowsMoved, this, &AppGridView::clearPageCache);
+}
+
+/**
+ * @brief AppGridView::setPageCacheEnabled 翻页动画开始时开启, 动画过程中每一帧只绘制缓存的页面内容, 不再逐个绘制 item
+ * 关闭时释放缓存, 视图大小的图片占用内存较多
+ * @param enabled 是否使用页面缓存
+ */
+void AppGridView::setPageCacheEnabled(bool enabled)
+{
+    if (m_pageCacheEnabled == enabled)
+        return;
+
+    m_pageCacheEnabled = enabled;
+    if (!enabled)
+        clearPageCache();
+
+    viewport()->update();
+}
+
+bool AppGridView::isRenderingPageCache() const
+{
+    return m_renderingPageCache;
+}
+
+void AppGridView::clearPageCache()
+{
+    m_pageCache = QPixmap();
+}
+
+/**
+ * @brief AppGridView::updatePageCache 将当前页的内容绘制到缓存中, 缓存按屏幕缩放比例生成
+ */
+void AppGridView::updatePageCache()
+{
+    const qreal ratio = devicePixelRatioF();
+    QPixmap pixmap(viewport()->size() * ratio);
+    pixmap.setDevicePixelRatio(ratio);
+    pixmap.fill(Qt::transparent);
+
+    m_renderingPageCache = true;
+    viewport()->render(&pixmap, QPoint(), QRegion(), QWidget::DrawChildren);
+    m_renderingPageCache = false;
+
+    m_pageCache = pixmap;
+}
+
+void AppGridView::paintEvent(QPaintEvent *e)
+{
+    if (!m_pageCacheEnabled || m_renderingPageCache) {
+        QListView::paintEvent(e);
+        return;
+    }
+
+    const qreal ratio = devicePixelRatioF();
+    if (m_pageCache.isNull() || !qFuzzyCompare(m_pageCache.devicePixelRatio(), ratio)
+            || m_pageCache.size() != viewport()->size() * ratio)
+        updatePageCache();
+
+    QPainter painter(viewport());
+    const QRect &rect = e->rect();
+    painter.drawPixmap(rect, m_pageCache, QRectF(QPointF(rect.topLeft()) * ratio, QSizeF(rect.size()) * ratio));
+}
+
 void AppGridView::initConnection()
 {
 #ifndef DISABLE_DRAG_ANIMATION
@@ -982,6 +1072,8 @@ void AppGridView::onLayoutChanged()
         setSpacing(itemSpacing);
         setViewportMargins(leftMargin, topMargin, leftMargin, 0);
     }
+
+    clearPageCache();
 }
 
 void AppGridView::onTouchSinglePresse(int time, double scalex, double scaley)
@@ -1003,5 +1095,6 @@ void AppGridView::onTouchUpOrDown(double scalex, double scaley)
 
 void AppGridView::onThemeChanged(DGuiApplicationHelper::ColorType)
 {
+    clearPageCache();
     update();
 }
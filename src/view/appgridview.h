@@ -64,6 +64,10 @@ public:
     void setViewMoveState(bool moving = false);
     bool getViewMoveState() const;
 
+    void setModel(QAbstractItemModel *model) override;
+    void setPageCacheEnabled(bool enabled);
+    bool isRenderingPageCache() const;
+
 private:
     void createMovingComponent();
     void initConnection();
@@ -71,6 +75,7 @@ private:
 
 public slots:
     void setDragAnimationEnable() { m_enableAnimation = true; }
+    void clearPageCache();
 
 private slots:
     void onLayoutChanged();
@@ -97,6 +102,7 @@ protected:
     void mousePressEvent(QMouseEvent *e) override;
     void mouseMoveEvent(QMouseEvent *e) override;
     void mouseReleaseEvent(QMouseEvent *e) override;
+    void paintEvent(QPaintEvent *e) override;
 
 private slots:
     void dropSwap();
@@ -104,6 +110,9 @@ private slots:
     void prepareDropSwap();
     void createFakeAnimation(const int pos, const bool moveNext, const int rIndex, const bool isLastAni = false);
 
+private:
+    void updatePageCache();
+
 private:
     int m_dropToPos;
     bool m_enableDropInside = false;                     // 拖拽释放后鼠标所在位置是否在listview范围内的标识
@@ -134,6 +143,10 @@ private:
     QLabel *m_weekLabel;
     ViewType m_viewType;
     QString m_appKey;
+
+    bool m_pageCacheEnabled = false;                     // 翻页动画过程中使用缓存的页面内容绘制
+    bool m_renderingPageCache = false;                   // 正在生成页面缓存
+    QPixmap m_pageCache;                                 // 不含悬停、选中样式的页面内容
 };
 
 typedef QList<AppGridView *> AppGridViewList;
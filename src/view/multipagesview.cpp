@@ -33,6 +33,7 @@ MultiPagesView::MultiPagesView(AppsListModel::AppCategory categoryModel, QWidget
     , m_pageCount(0)
     , m_pageIndex(0)
     , m_bDragStart(false)
+    , m_bDragPaging(false)
     , m_bMousePress(false)
     , m_nMousePos(0)
     , m_scrollValue(0)
@@ -123,6 +124,7 @@ void MultiPagesView::updateGradient(QPixmap &pixmap, QPoint topLeftImg, QPoint t
 
 /**
  * @brief MultiPagesView::updatePageCount 更新分页控件信息
+ * 只为当前页及相邻的页创建视图, 其余页面只有占位控件, 应用数量较多时视图和模型的个数不变
  * @param category 应用分类类型
  */
 void MultiPagesView::updatePageCount(AppsListModel::AppCategory category)
@@ -138,63 +140,159 @@ void MultiPagesView::updatePageCount(AppsListModel::AppCategory category)
     if (pageCount == m_pageCount)
         return;
 
-    if (pageCount > m_pageCount) {
-        while (pageCount > m_pageCount) {
-            AppsListModel *pModel = new AppsListModel(m_category);
-            pModel->setPageIndex(m_pageCount);
-            m_pageAppsModelList.push_back(pModel);
-
-            AppGridView *pageView = Q_NULLPTR;
-            if (category == AppsListModel::FullscreenAll) {
-                pageView = new AppGridView(AppGridView::MainView, this);
-            } else {
-                // m_category == AppsListModel::Dir的时候
-                pageView = new AppGridView(AppGridView::PopupView, this);
-            }
-
-            pageView->setModel(pModel);
-            pageView->setItemDelegate(m_delegate);
-            pageView->setContainerBox(m_appListArea);
-            pageView->installEventFilter(this);
-            pageView->setDelegate(this);
-            m_appGridViewList.push_back(pageView);
-
-            m_viewBox->layout()->insertWidget(m_pageCount, pageView);
-
-            m_pageCount++;
-
-            connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
-            connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
-            connect(pageView, &AppGridView::requestScrollStop, [this] {
-                m_bDragStart = false;
-                setGradientVisible(false);
-            });
-            connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,pageView,&AppGridView::setDragAnimationEnable);
-            connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,this, [ = ] {
-                    setGradientVisible(false);
-            });
-            emit connectViewEvent(pageView);
-            // 新增的页面需要设置一下大小
-            updatePosition();
-        }
-    } else {
-        while (pageCount < m_pageCount) {
-            AppGridView *pageView = qobject_cast<AppGridView *>(m_viewBox->layout()->itemAt(m_pageCount - 1)->widget());
-            m_viewBox->layout()->removeWidget(pageView);
-            pageView->model()->deleteLater();
-            pageView->deleteLater();
+    while (pageCount > m_pageCount) {
+        QWidget *placeholder = new QWidget(m_viewBox);
+        m_pagePlaceholders.push_back(placeholder);
+        m_appGridViewList.push_back(Q_NULLPTR);
+        m_pageAppsModelList.push_back(Q_NULLPTR);
 
-            m_pageAppsModelList.removeLast();
-            m_appGridViewList.removeLast();
+        m_viewBox->layout()->insertWidget(m_pageCount, placeholder);
 
-            m_pageCount--;
-        }
+        m_pageCount++;
+
+        // 新增的页面需要设置一下大小
+        updatePosition();
+    }
+
+    while (pageCount < m_pageCount) {
+        detachPage(m_pageCount - 1);
+
+        QWidget *placeholder = m_pagePlaceholders.takeLast();
+        m_viewBox->layout()->removeWidget(placeholder);
+        placeholder->deleteLater();
+
+        m_pageAppsModelList.removeLast();
+        m_appGridViewList.removeLast();
+
+        m_pageCount--;
     }
 
+    m_pageIndex = qMin(m_pageIndex, m_pageCount - 1);
+    updatePageWindow();
+
     m_pageControl->setPageCount(m_pageCount > 1 ? pageCount : 0);
 }
 
+/**
+ * @brief MultiPagesView::createPageView 创建一个视图及其模型, 之后通过 attachPage() 在各页之间复用
+ * @return 新建的视图
+ */
+AppGridView *MultiPagesView::createPageView()
+{
+    AppGridView *pageView = Q_NULLPTR;
+    if (m_category == AppsListModel::Dir)
+        pageView = new AppGridView(AppGridView::PopupView, this);
+    else
+        pageView = new AppGridView(AppGridView::MainView, this);
+
+    pageView->setModel(new AppsListModel(m_category, pageView));
+    pageView->setItemDelegate(m_delegate);
+    pageView->setContainerBox(m_appListArea);
+    pageView->installEventFilter(this);
+    pageView->setDelegate(this);
+    pageView->hide();
+    if (m_pageSize.isValid())
+        pageView->setFixedSize(m_pageSize);
+
+    m_pageViewPool.push_back(pageView);
+
+    connect(pageView, &AppGridView::requestScrollLeft, this, &MultiPagesView::dragToLeft);
+    connect(pageView, &AppGridView::requestScrollRight, this, &MultiPagesView::dragToRight);
+    connect(pageView, &AppGridView::requestScrollStop, [this] {
+        m_bDragStart = false;
+        setGradientVisible(false);
+    });
+    connect(pageView, &AppGridView::dragEnd, this, &MultiPagesView::dragStop);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,pageView,&AppGridView::setDragAnimationEnable);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished,this, [ = ] {
+            setGradientVisible(false);
+    });
+    emit connectViewEvent(pageView);
+
+    return pageView;
+}
+
+/**
+ * @brief MultiPagesView::attachPage 取一个空闲的视图显示该页, 代替该页的占位控件
+ * @param page 页码
+ */
+void MultiPagesView::attachPage(int page)
+{
+    if (m_appGridViewList[page])
+        return;
+
+    AppGridView *pageView = Q_NULLPTR;
+    for (AppGridView *view : m_pageViewPool) {
+        if (!m_appGridViewList.contains(view)) {
+            pageView = view;
+            break;
+        }
+    }
+
+    if (!pageView)
+        pageView = createPageView();
+
+    AppsListModel *pageModel = qobject_cast<AppsListModel *>(pageView->model());
+    pageModel->setPageIndex(page);
+    m_appGridViewList[page] = pageView;
+    m_pageAppsModelList[page] = pageModel;
+
+    delete m_viewBox->layout()->replaceWidget(m_pagePlaceholders[page], pageView);
+    m_pagePlaceholders[page]->hide();
+    pageView->show();
+}
+
+/**
+ * @brief MultiPagesView::detachPage 回收该页的视图, 由占位控件代替
+ * @param page 页码
+ */
+void MultiPagesView::detachPage(int page)
+{
+    AppGridView *pageView = m_appGridViewList[page];
+    if (!pageView)
+        return;
+
+    delete m_viewBox->layout()->replaceWidget(pageView, m_pagePlaceholders[page]);
+    pageView->hide();
+    pageView->setPageCacheEnabled(false);
+    m_pagePlaceholders[page]->show();
+
+    m_appGridViewList[page] = Q_NULLPTR;
+    m_pageAppsModelList[page] = Q_NULLPTR;
+}
+
+/**
+ * @brief MultiPagesView::updatePageWindow 为当前页及相邻的页分配视图, 回收其余页面的视图
+ */
+void MultiPagesView::updatePageWindow()
+{
+    const int firstPage = qMax(0, m_pageIndex - 1);
+    const int lastPage = qMin(m_pageCount - 1, m_pageIndex + 1);
+
+    // 翻页过程中之前的页面仍然可见, 跨页拖拽时拖拽开始的视图仍在执行拖拽, 结束后再回收
+    const bool releasePages = m_pageSwitchAnimation->state() != QPropertyAnimation::Running && !m_bDragPaging;
+
+    for (int page = 0; page < m_pageCount; ++page) {
+        if (page >= firstPage && page <= lastPage)
+            attachPage(page);
+        else if (releasePages)
+            detachPage(page);
+    }
+}
+
+/**
+ * @brief MultiPagesView::pageWidget 获取该页在滚动区域中的控件
+ * @param page 页码
+ * @return 已分配视图时返回视图, 否则返回占位控件
+ */
+QWidget *MultiPagesView::pageWidget(int page) const
+{
+    if (m_appGridViewList[page])
+        return m_appGridViewList[page];
+
+    return m_pagePlaceholders[page];
+}
+
 /**
  * @brief MultiPagesView::dragToLeft 在当前列表页向左拖动item
  * @param index 拖动item对应的模型索引
@@ -210,6 +308,9 @@ void MultiPagesView::dragToLeft(const QModelIndex &index)
 
     m_appGridViewList[m_pageIndex]->dragOut(-1);
 
+    // 先标记拖拽状态, 翻页时不使用页面缓存
+    m_bDragStart = true;
+    m_bDragPaging = true;
     showCurrentPage(m_pageIndex - 1);
 
     int lastApp = m_pageAppsModelList[m_pageIndex]->rowCount(QModelIndex());
@@ -219,8 +320,6 @@ void MultiPagesView::dragToLeft(const QModelIndex &index)
     // 保存向左拖拽后item回归的终点位置
     const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(firstModel).topLeft();
     m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
-
-    m_bDragStart = true;
 }
 
 /**
@@ -241,7 +340,9 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
     // 下一页的末尾位置
     m_appGridViewList[m_pageIndex]->dragOut(newPos * 2 - 1);
 
-    // 展开下一页
+    // 展开下一页, 先标记拖拽状态, 翻页时不使用页面缓存
+    m_bDragStart = true;
+    m_bDragPaging = true;
     showCurrentPage(m_pageIndex + 1);
 
     // 将最后一个App'挤走'
@@ -252,8 +353,6 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
     // 保存向右拖拽后item回归的终点位置
     const QPoint &dropCursorPoint = m_appGridViewList[m_pageIndex]->appIconRect(lastModel).topLeft();
     m_appGridViewList[m_pageIndex]->setDropAndLastPos(dropCursorPoint);
-
-    m_bDragStart = true;
 }
 
 /**
@@ -261,6 +360,12 @@ void MultiPagesView::dragToRight(const QModelIndex &index)
  */
 void MultiPagesView::dragStop()
 {
+    // 拖拽结束后回收不再需要的页面, 等拖拽开始的视图处理完成后再执行
+    if (m_bDragPaging) {
+        m_bDragPaging = false;
+        QMetaObject::invokeMethod(this, "updatePageWindow", Qt::QueuedConnection);
+    }
+
     if (sender() == m_appGridViewList[m_pageIndex])
         return;
 
@@ -301,14 +406,11 @@ void MultiPagesView::setDataDelegate(QAbstractItemDelegate *delegate)
  */
 void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
 {
-    int pageCount = m_appsManager->getPageCount(category);
-    for (int i = 0; i < qMax(pageCount, m_pageCount); i++) {
-        m_appGridViewList[i]->setVisible(i < pageCount);
-        m_pageAppsModelList[i]->setCategory(category);
-    }
-    m_pageControl->setPageCount(pageCount > 1 ? pageCount : 0);
-    m_pageCount = pageCount;
     m_category = category;
+    for (AppGridView *pageView : m_pageViewPool)
+        qobject_cast<AppsListModel *>(pageView->model())->setCategory(category);
+
+    updatePageCount(category);
 }
 
 /**
@@ -317,10 +419,8 @@ void MultiPagesView::ShowPageView(AppsListModel::AppCategory category)
  */
 void MultiPagesView::setModel(AppsListModel::AppCategory category)
 {
-    for (int i = 0; i < m_pageCount; i++) {
-        m_pageAppsModelList[i]->setCategory(category);
-        m_appGridViewList[i]->setModel(m_pageAppsModelList[i]);
-    }
+    for (AppGridView *pageView : m_pageViewPool)
+        qobject_cast<AppsListModel *>(pageView->model())->setCategory(category);
 }
 
 /**
@@ -338,9 +438,12 @@ void MultiPagesView::updatePosition(int mode)
     QSize tmpSize = size() - QSize(remainSpacing, m_pageControl->height() + DLauncher::DRAG_THRESHOLD);
     m_appListArea->setFixedSize(tmpSize);
     m_viewBox->setFixedSize(tmpSize);
+    m_pageSize = tmpSize;
 
-    for (auto pView : m_appGridViewList)
+    for (auto pView : m_pageViewPool)
         pView->setFixedSize(tmpSize);
+    for (auto placeholder : m_pagePlaceholders)
+        placeholder->setFixedSize(tmpSize);
     m_viewBox->layout()->setContentsMargins(0, 0, 0, 0);
     m_viewBox->layout()->setSpacing(0);
     m_pageControl->updateIconSize(m_calcUtil->getScreenScaleX(), m_calcUtil->getScreenScaleY());
@@ -368,13 +471,21 @@ void MultiPagesView::initUi()
 void MultiPagesView::initConnection()
 {
     connect(m_pageControl, &PageControl::onPageChanged, this, &MultiPagesView::showCurrentPage);
+    connect(m_pageSwitchAnimation, &QPropertyAnimation::finished, this, [ this ] {
+        for (AppGridView *pageView : m_pageViewPool)
+            pageView->setPageCacheEnabled(false);
+
+        updatePageWindow();
+    });
     connect(m_titleLabel, &EditLabel::titleChanged, this, &MultiPagesView::titleChanged);
 }
 
 void MultiPagesView::showCurrentPage(int currentPage)
 {
     m_pageIndex = ((currentPage > 0) ? (currentPage < m_pageCount ? currentPage : m_pageCount - 1) : 0);
-    int endValue = ((m_pageIndex == 0) ? 0 : (m_appGridViewList[m_pageIndex]->x()));
+    updatePageWindow();
+
+    int endValue = ((m_pageIndex == 0) ? 0 : (pageWidget(m_pageIndex)->x()));
     int startValue = m_appListArea->horizontalScrollValue();
 
     m_appListArea->setProperty("curPage", m_pageIndex);
@@ -382,6 +493,15 @@ void MultiPagesView::showCurrentPage(int currentPage)
     m_pageSwitchAnimation->stop();
     m_pageSwitchAnimation->setStartValue(startValue);
     m_pageSwitchAnimation->setEndValue(endValue);
+
+    // 翻页过程中各页面只绘制缓存的内容, 拖拽应用跨页时页面内容会变化, 不使用缓存
+    if (startValue != endValue && !m_bDragStart) {
+        for (AppGridView *pageView : m_appGridViewList) {
+            if (pageView)
+                pageView->setPageCacheEnabled(true);
+        }
+    }
+
     m_pageSwitchAnimation->start();
 
     if (m_changePageDelayTime)
@@ -399,8 +519,9 @@ QModelIndex MultiPagesView::selectApp(const int key)
             -- page;
             itemSelect = m_calcUtil->appPageItemCount(m_category) - 1;
         } else {
+            // 最后一页可能尚未创建视图, 根据应用个数计算最后一个应用的位置
             page = m_pageCount - 1;
-            itemSelect = m_pageAppsModelList[page]->rowCount(QModelIndex()) - 1;
+            itemSelect = m_appsManager->appsInfoListSize(m_category) - m_calcUtil->appPageItemCount(m_category) * page - 1;
         }
     } else {
         if (page + 1 < m_pageCount) {
@@ -629,4 +750,5 @@ void MultiPagesView::resetCurPageIndex()
 {
     m_pageIndex = 0;
     m_appListArea->setHorizontalScrollValue(0);
+    updatePageWindow();
 }
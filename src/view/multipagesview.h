@@ -88,10 +88,15 @@ private slots:
     void dragToLeft(const QModelIndex &index);
     void dragToRight(const QModelIndex &index);
     void dragStop();
+    void updatePageWindow();
 
 private:
     void initUi();
     void initConnection();
+    AppGridView *createPageView();
+    void attachPage(int page);
+    void detachPage(int page);
+    QWidget *pageWidget(int page) const;
 
 protected:
     void wheelEvent(QWheelEvent *e) Q_DECL_OVERRIDE;
@@ -104,8 +109,11 @@ private:
     AppsManager *m_appsManager;                         // 应用管理类
     CalculateUtil *m_calcUtil;                          // 界面布局计算类
     AppListArea *m_appListArea;                         // 滑动区域控件
-    AppGridViewList m_appGridViewList;                  // 多视图列表
-    PageAppsModelist m_pageAppsModelList;               // 多视图模型列表
+    AppGridViewList m_appGridViewList;                  // 各页的视图, 未创建视图的页为空
+    PageAppsModelist m_pageAppsModelList;               // 各页的模型, 未创建视图的页为空
+    QList<QWidget *> m_pagePlaceholders;                // 各页的占位控件, 未创建视图时代替视图占据该页的位置
+    AppGridViewList m_pageViewPool;                     // 已创建的视图, 翻页时在各页之间复用
+    QSize m_pageSize;                                   // 每页的大小
 
     DHBoxWidget *m_viewBox;
 
@@ -120,6 +128,7 @@ private:
     int m_pageIndex;
 
     bool m_bDragStart;
+    bool m_bDragPaging;                                 // 跨页拖拽尚未结束, 拖拽开始时的页面暂不回收
     bool m_bMousePress;
     int m_nMousePos;
     int m_scrollValue;
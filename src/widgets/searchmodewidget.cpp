@@ -158,6 +158,16 @@ void SearchModeWidget::initAppView()
 void SearchModeWidget::initConnection()
 {
     connect(CalculateUtil::instance(), &CalculateUtil::layoutChanged, this, &SearchModeWidget::onLayoutChanged);
+
+    // 插件搜索结果异步返回, 结果变化时更新应用商店搜索结果区域的显示状态
+    auto updateOutsideVisible = [ this ] {
+        m_outsideWidget->setVisible(m_outsideModel->rowCount(QModelIndex()) > 0);
+    };
+    connect(m_outsideModel, &AppsListModel::layoutChanged, this, updateOutsideVisible);
+    connect(m_outsideModel, &AppsListModel::modelReset, this, updateOutsideVisible);
+    connect(m_outsideModel, &AppsListModel::rowsInserted, this, updateOutsideVisible);
+    connect(m_outsideModel, &AppsListModel::rowsRemoved, this, updateOutsideVisible);
+
     QMetaObject::invokeMethod(this, "connectViewEvent", Qt::QueuedConnection, Q_ARG(AppGridView *, m_nativeView));
     QMetaObject::invokeMethod(this, "connectViewEvent", Qt::QueuedConnection, Q_ARG(AppGridView *, m_outsideView));
 }
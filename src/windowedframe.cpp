@@ -5,6 +5,7 @@
 #include "windowedframe.h"
 #include "global_util/util.h"
 #include "dbusdockinterface.h"
+#include "dbusproxyregistry.h"
 #include "constants.h"
 #include "appitemdelegate.h"
 
@@ -61,7 +62,7 @@ inline const QPoint scaledPosition(const QPoint &xpos)
  */
 WindowedFrame::WindowedFrame(QWidget *parent)
     : DBlurEffectWidget(parent)
-    , m_amDbusDockInter(new AMDBusDockInter(this))
+    , m_amDbusDockInter(DBusProxyRegistry::instance()->proxy<AMDBusDockInter>())
     , m_menuWorker(new MenuWorker(this))
     , m_eventFilter(new SharedEventFilter(this))
     , m_windowHandle(this, this)
@@ -140,8 +141,6 @@ void WindowedFrame::initUi()
     m_favoriteView->setAcceptDrops(true);
 
     m_filterModel->setSourceModel(m_allAppsModel);
-    m_filterModel->setFilterRole(AppsListModel::AppRawItemInfoRole);
-    m_filterModel->setFilterKeyColumn(0);
     m_filterModel->setSortCaseSensitivity(Qt::CaseInsensitive);
 
     m_allAppView->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -1335,9 +1334,8 @@ void WindowedFrame::searchText(const QString &text)
         keyWord = keyWord.remove(QRegExp("\\s"));
         emit searchApp(keyWord);
 
-        QRegExp regExp(keyWord, Qt::CaseInsensitive);
         searchAppState(true);
-        m_filterModel->setFilterRegExp(regExp);
+        m_filterModel->setSearchText(keyWord);
         m_searchWidget->setSearchModel(m_filterModel);
         m_focusPos = Search;
         m_searchWidget->selectFirstItem();
@@ -1400,8 +1398,7 @@ void WindowedFrame::onScreenInfoChange()
 void WindowedFrame::updatePosition()
 {
     // 该接口获取数据是翻转后的数据
-    DBusDockInterface inter;
-    QRect dockGeo = inter.geometry();
+    QRect dockGeo = DBusProxyRegistry::instance()->proxy<DBusDockInterface>()->geometry();
     QRect dockRect = QRect(scaledPosition(dockGeo.topLeft()),scaledPosition(dockGeo.bottomRight()));
 
     int dockSpacing = 0;
@@ -0,0 +1,364 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconrenderworker.h"
+#include "iconcachemanager.h"
+#include "iconatlas.h"
+#include "util.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QIcon>
+#include <QImageReader>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QPixmap>
+#include <QSettings>
+#include <QSvgRenderer>
+#include <QThreadPool>
+#include <QTimer>
+#include <QtConcurrent>
+
+#include <DGuiApplicationHelper>
+#include <DPlatformTheme>
+
+#include <algorithm>
+
+DGUI_USE_NAMESPACE
+
+namespace {
+
+struct ThemeDirectory
+{
+    QString path;           // 相对于主题目录的子目录
+    QString type;           // Fixed, Scalable, Threshold
+    int size;
+    int minSize;
+    int maxSize;
+    int threshold;
+    int scale;
+};
+
+struct IconTheme
+{
+    QStringList baseDirs;                   // 各个搜索路径下的主题目录
+    QList<ThemeDirectory> directories;
+    QStringList inherits;
+};
+
+}
+
+static const QStringList ICON_SUFFIXES = { ".svg", ".png", ".xpm" };
+static const int MAX_RETRY_TIMES = 20;
+
+static QMutex ThemeMutex;
+static QHash<QString, IconTheme> ThemeCache;            // (主题名称, 搜索路径) -> 主题目录信息
+
+/**
+ * @brief loadIconTheme 解析主题目录下的 index.theme, 解析结果在多个渲染线程间共享
+ * @param themeName 主题名称
+ * @param searchPaths 主题搜索路径
+ * @return 主题目录信息
+ */
+static IconTheme loadIconTheme(const QString &themeName, const QStringList &searchPaths)
+{
+    QMutexLocker locker(&ThemeMutex);
+
+    const QString cacheKey = themeName + "|" + searchPaths.join(":");
+    auto it = ThemeCache.constFind(cacheKey);
+    if (it != ThemeCache.constEnd())
+        return it.value();
+
+    IconTheme theme;
+    for (const QString &searchPath : searchPaths) {
+        const QString themeDir = searchPath + "/" + themeName;
+        if (!QFileInfo::exists(themeDir))
+            continue;
+
+        theme.baseDirs << themeDir;
+
+        const QString indexFile = themeDir + "/index.theme";
+        if (!theme.directories.isEmpty() || !QFile::exists(indexFile))
+            continue;
+
+        // 与 QIconLoader 的解析方式一致, 形如 "48x48/apps/Size" 的键即为一个图标目录
+        const QSettings index(indexFile, QSettings::IniFormat);
+        for (const QString &key : index.allKeys()) {
+            if (!key.endsWith("/Size"))
+                continue;
+
+            bool ok = false;
+            const int size = index.value(key).toInt(&ok);
+            if (!ok)
+                continue;
+
+            ThemeDirectory directory;
+            directory.path = key.left(key.size() - 5);
+            directory.size = size;
+            directory.type = index.value(directory.path + "/Type", "Threshold").toString();
+            directory.minSize = index.value(directory.path + "/MinSize", size).toInt();
+            directory.maxSize = index.value(directory.path + "/MaxSize", size).toInt();
+            directory.threshold = index.value(directory.path + "/Threshold", 2).toInt();
+            directory.scale = qMax(1, index.value(directory.path + "/Scale", 1).toInt());
+            theme.directories << directory;
+        }
+
+        theme.inherits = index.value("Icon Theme/Inherits").toStringList();
+    }
+
+    ThemeCache.insert(cacheKey, theme);
+    return theme;
+}
+
+/**
+ * @brief clearIconThemes 清除解析过的主题目录信息, 主题安装或更新后重新解析
+ */
+static void clearIconThemes()
+{
+    QMutexLocker locker(&ThemeMutex);
+    ThemeCache.clear();
+}
+
+/**
+ * @brief directorySizeDistance 按照 freedesktop 图标主题规范计算目录尺寸与目标尺寸的差距
+ */
+static int directorySizeDistance(const ThemeDirectory &directory, const int size)
+{
+    const int scale = directory.scale;
+    if (directory.type == "Fixed")
+        return qAbs(directory.size * scale - size);
+
+    if (directory.type == "Scalable") {
+        if (size < directory.minSize * scale)
+            return directory.minSize * scale - size;
+
+        if (size > directory.maxSize * scale)
+            return size - directory.maxSize * scale;
+
+        return 0;
+    }
+
+    if (size < (directory.size - directory.threshold) * scale)
+        return (directory.size - directory.threshold) * scale - size;
+
+    if (size > (directory.size + directory.threshold) * scale)
+        return size - (directory.size + directory.threshold) * scale;
+
+    return 0;
+}
+
+QPointer<IconRenderWorker> IconRenderWorker::INSTANCE = nullptr;
+
+IconRenderWorker *IconRenderWorker::instance()
+{
+    if (INSTANCE.isNull())
+        INSTANCE = new IconRenderWorker;
+
+    return INSTANCE;
+}
+
+IconRenderWorker::IconRenderWorker(QObject *parent)
+    : QObject(parent)
+    , m_threadPool(new QThreadPool(this))
+{
+    m_threadPool->setMaxThreadCount(qBound(1, QThread::idealThreadCount() / 2, 4));
+
+    // 图标主题变化后重新解析主题目录, 之前找不到的图标也重新查找
+    connect(DGuiApplicationHelper::instance()->systemTheme(), &DPlatformTheme::iconThemeNameChanged, this, [ this ] {
+        clearIconThemes();
+        m_failedKeys.clear();
+        m_retryTimes.clear();
+    });
+}
+
+/**
+ * @brief IconRenderWorker::requestIcon 提交后台渲染任务, 同一图标在渲染完成前只提交一次
+ * @param itemInfo 应用信息
+ * @param size 图标大小
+ * @param ratio 缩放比
+ */
+void IconRenderWorker::requestIcon(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio)
+{
+    const QString key = cacheKey(itemInfo, size, ratio);
+    if (m_pendingKeys.contains(key) || m_failedKeys.contains(key))
+        return;
+
+    m_pendingKeys.insert(key);
+
+    // 图标名称与主题信息在主线程中获取, 渲染线程中只访问文件
+    const QString iconName = appIconName(itemInfo);
+    const QString themeName = QIcon::themeName();
+    const QStringList searchPaths = QIcon::themeSearchPaths();
+
+    QFutureWatcher<QImage> *watcher = new QFutureWatcher<QImage>(this);
+    connect(watcher, &QFutureWatcher<QImage>::finished, this, [ = ] {
+        m_pendingKeys.remove(key);
+        onRenderFinished(itemInfo, size, ratio, watcher->result());
+        watcher->deleteLater();
+    });
+
+    watcher->setFuture(QtConcurrent::run(m_threadPool, &IconRenderWorker::renderIcon, iconName, themeName, searchPaths, size, ratio));
+}
+
+/**
+ * @brief IconRenderWorker::renderIcon 在渲染线程中光栅化图标
+ * @param iconName 图标名称、图标文件路径或 base64 编码的图片数据
+ * @param themeName 图标主题名称
+ * @param searchPaths 图标主题搜索路径
+ * @param size 图标大小
+ * @param ratio 缩放比
+ * @return 图标图片, 找不到图标时返回空图片
+ */
+QImage IconRenderWorker::renderIcon(const QString &iconName, const QString &themeName, const QStringList &searchPaths, const int size, const qreal ratio)
+{
+    const int pixelSize = qRound(size * ratio);
+    QImage image;
+
+    if (iconName.isEmpty() || pixelSize <= 0)
+        return image;
+
+    if (iconName.startsWith("data:image/")) {
+        const QStringList strs = iconName.split("base64,");
+        if (strs.size() == 2)
+            image.loadFromData(QByteArray::fromBase64(strs.at(1).toLatin1()));
+    } else {
+        const QString filePath = QFileInfo(iconName).isAbsolute() ? iconName
+                                                                  : lookupIconPath(iconName, themeName, searchPaths, pixelSize);
+        if (filePath.isEmpty() || !QFile::exists(filePath))
+            return image;
+
+        if (filePath.endsWith(".svg")) {
+            QSvgRenderer renderer(filePath);
+            if (renderer.isValid()) {
+                image = QImage(pixelSize, pixelSize, QImage::Format_ARGB32_Premultiplied);
+                image.fill(Qt::transparent);
+
+                QPainter painter(&image);
+                painter.setRenderHint(QPainter::Antialiasing, true);
+                renderer.render(&painter);
+                painter.end();
+            }
+        } else {
+            QImageReader reader(filePath);
+            const QSize imageSize = reader.size();
+            if (imageSize.isValid() && reader.supportsOption(QImageIOHandler::ScaledSize))
+                reader.setScaledSize(imageSize.scaled(pixelSize, pixelSize, Qt::KeepAspectRatio));
+
+            image = reader.read();
+        }
+    }
+
+    if (!image.isNull() && image.size() != QSize(pixelSize, pixelSize))
+        image = image.scaled(QSize(pixelSize, pixelSize), Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    return image;
+}
+
+/**
+ * @brief IconRenderWorker::lookupIconPath 按照图标主题的继承关系查找尺寸最接近的图标文件
+ * @param iconName 图标名称
+ * @param themeName 图标主题名称
+ * @param searchPaths 图标主题搜索路径
+ * @param size 图标的像素大小
+ * @return 图标文件路径, 找不到时返回空字符串
+ */
+QString IconRenderWorker::lookupIconPath(const QString &iconName, const QString &themeName, const QStringList &searchPaths, const int size)
+{
+    QStringList themeQueue { themeName };
+    QSet<QString> visitedThemes;
+
+    while (!themeQueue.isEmpty()) {
+        const QString name = themeQueue.takeFirst();
+        if (name.isEmpty() || visitedThemes.contains(name))
+            continue;
+
+        visitedThemes.insert(name);
+        const IconTheme theme = loadIconTheme(name, searchPaths);
+
+        QList<QPair<int, const ThemeDirectory *>> directories;
+        for (const ThemeDirectory &directory : theme.directories)
+            directories << qMakePair(directorySizeDistance(directory, size), &directory);
+
+        std::stable_sort(directories.begin(), directories.end(), [](const QPair<int, const ThemeDirectory *> &d1, const QPair<int, const ThemeDirectory *> &d2) {
+            return d1.first < d2.first;
+        });
+
+        for (const auto &directory : directories) {
+            for (const QString &baseDir : theme.baseDirs) {
+                for (const QString &suffix : ICON_SUFFIXES) {
+                    const QString filePath = QString("%1/%2/%3%4").arg(baseDir).arg(directory.second->path).arg(iconName).arg(suffix);
+                    if (QFile::exists(filePath))
+                        return filePath;
+                }
+            }
+        }
+
+        themeQueue << theme.inherits;
+        if (themeQueue.isEmpty() && !visitedThemes.contains("hicolor"))
+            themeQueue << "hicolor";
+    }
+
+    for (const QString &suffix : ICON_SUFFIXES) {
+        const QString filePath = QString("/usr/share/pixmaps/%1%2").arg(iconName).arg(suffix);
+        if (QFile::exists(filePath))
+            return filePath;
+    }
+
+    return QString();
+}
+
+void IconRenderWorker::onRenderFinished(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio, const QImage &image)
+{
+    const QString key = cacheKey(itemInfo, size, ratio);
+    QPixmap pixmap;
+
+    if (!image.isNull()) {
+        pixmap = QPixmap::fromImage(image);
+        pixmap.setDevicePixelRatio(ratio);
+    } else if (!getThemeIcon(pixmap, itemInfo, size)) {
+        // 渲染线程中找不到图标时(如 dci 等扩展格式), 在主线程中通过 QIcon 再查找一次, 仍然找不到则稍后重试
+        retryLater(itemInfo, size, ratio);
+        return;
+    }
+
+    if (pixmap.isNull())
+        return;
+
+    m_retryTimes.remove(key);
+    IconCacheManager::instance()->insert(key, pixmap);
+    IconAtlas::instance()->insert(key, itemInfo.m_desktop, image.isNull() ? pixmap.toImage() : image, ratio);
+    emit iconRendered(itemInfo.m_desktop);
+}
+
+void IconRenderWorker::retryLater(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio)
+{
+    const QString key = cacheKey(itemInfo, size, ratio);
+    const int retryTimes = m_retryTimes.value(key, 0);
+    if (retryTimes >= MAX_RETRY_TIMES) {
+        // 不再重试, 之后直接显示齿轮图标, 不再提交渲染任务
+        qDebug() << "failed to get icon:" << itemInfo.m_iconKey << ", desktop:" << itemInfo.m_desktop;
+        m_retryTimes.remove(key);
+        m_failedKeys.insert(key);
+        return;
+    }
+
+    m_retryTimes.insert(key, retryTimes + 1);
+
+    // 等待重试期间不重复提交渲染任务
+    m_pendingKeys.insert(key);
+
+    // 重新设置搜索路径以清除 QIcon 及渲染线程的主题缓存, 新安装的应用图标可能刚写入主题目录
+    if (!QFile::exists(itemInfo.m_iconKey)) {
+        QIcon::setThemeSearchPaths(QIcon::themeSearchPaths());
+        clearIconThemes();
+    }
+
+    QTimer::singleShot((retryTimes < MAX_RETRY_TIMES / 2 ? 5 : 10) * 1000, this, [ = ] {
+        m_pendingKeys.remove(key);
+        requestIcon(itemInfo, size, ratio);
+    });
+}
@@ -0,0 +1,53 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ICONRENDERWORKER_H
+#define ICONRENDERWORKER_H
+
+#include "iteminfo.h"
+
+#include <QObject>
+#include <QImage>
+#include <QHash>
+#include <QSet>
+#include <QPointer>
+
+class QThreadPool;
+
+/**后台渲染应用图标
+ * 在独立线程中根据图标文件路径查找并光栅化图标(QImage), 不访问 QIcon, 避免多线程访问 QIcon 导致崩溃,
+ * 渲染完成后在主线程中转换为 QPixmap 并写入图标缓存, 然后通知界面刷新对应的应用
+ * @brief The IconRenderWorker class
+ */
+class IconRenderWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    static IconRenderWorker *instance();
+
+    void requestIcon(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio);
+
+    static QImage renderIcon(const QString &iconName, const QString &themeName, const QStringList &searchPaths, const int size, const qreal ratio);
+    static QString lookupIconPath(const QString &iconName, const QString &themeName, const QStringList &searchPaths, const int size);
+
+signals:
+    void iconRendered(const QString &desktop) const;
+
+private:
+    explicit IconRenderWorker(QObject *parent = nullptr);
+
+    void onRenderFinished(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio, const QImage &image);
+    void retryLater(const ItemInfo_v1 &itemInfo, const int size, const qreal ratio);
+
+private:
+    static QPointer<IconRenderWorker> INSTANCE;
+
+    QThreadPool *m_threadPool;
+    QSet<QString> m_pendingKeys;                        // 正在渲染或等待重试的图标, 避免重复提交
+    QHash<QString, int> m_retryTimes;                   // 图标获取失败后的重试次数
+    QSet<QString> m_failedKeys;                         // 多次重试后仍找不到的图标, 直接显示齿轮图标
+};
+
+#endif // ICONRENDERWORKER_H
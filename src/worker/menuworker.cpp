@@ -7,18 +7,26 @@
 #include "util.h"
 #include "amdbuslauncherinterface.h"
 #include "amdbusdockinterface.h"
+#include "dbusproxyregistry.h"
 
+#include <QElapsedTimer>
 #include <QSignalMapper>
 #include <QWindow>
 
 const bool IS_WAYLAND_DISPLAY = !qgetenv("WAYLAND_DISPLAY").isEmpty();
 
+static LatencyHistogram &menuLatencyHistogram()
+{
+    static LatencyHistogram histogram;
+    return histogram;
+}
+
 class AppsListModel;
 
 MenuWorker::MenuWorker(QObject *parent)
     : QObject(parent)
-    , m_amDbusLauncher(new AMDBusLauncherInter(this))
-    , m_amDbusDockInter(new AMDBusDockInter(this))
+    , m_amDbusLauncher(DBusProxyRegistry::instance()->proxy<AMDBusLauncherInter>())
+    , m_amDbusDockInter(DBusProxyRegistry::instance()->proxy<AMDBusDockInter>())
     , m_startManagerInterface(new DBusStartManager(this))
     , m_calcUtil(CalculateUtil::instance())
     , m_appManager(AppsManager::instance())
@@ -207,8 +215,19 @@ bool MenuWorker::isMenuVisible()
         return false;
 }
 
+/**
+ * @brief MenuWorker::menuOpenLatency 从请求打开右键菜单到菜单显示的耗时分布
+ */
+const LatencyHistogram &MenuWorker::menuOpenLatency()
+{
+    return menuLatencyHistogram();
+}
+
 void MenuWorker::showMenuByAppItem(QPoint pos, const QModelIndex &index)
 {
+    QElapsedTimer openTimer;
+    openTimer.start();
+
     setCurrentModelIndex(index);
 
     if (IS_WAYLAND_DISPLAY) {
@@ -239,6 +258,9 @@ void MenuWorker::showMenuByAppItem(QPoint pos, const QModelIndex &index)
     m_menu->show();
     m_menu->raise();
 
+    // 耗时分布通过 menuOpenLatency() 获取
+    menuLatencyHistogram().record(openTimer.nsecsElapsed() / 1000);
+
     qDebug() << "menu pos:" << pos << ", menu visible:" << m_menu->isVisible();
 
     // 保存右键菜单实际的物理大小(已将屏幕缩放考虑在内)
@@ -342,9 +364,11 @@ void MenuWorker::handleToStartup()
 void MenuWorker::handleToProxy()
 {
     m_amDbusLauncher->SetUseProxy(m_appKey, !m_isItemProxy);
+    m_appManager->updateAppStatus(m_appDesktop, AppStatusTable::UseProxy, !m_isItemProxy);
 }
 
 void MenuWorker::handleSwitchScaling()
 {
     m_amDbusLauncher->SetDisableScaling(m_appKey, m_isItemEnableScaling);
+    m_appManager->updateAppStatus(m_appDesktop, AppStatusTable::EnableScaling, !m_isItemEnableScaling);
 }
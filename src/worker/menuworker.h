@@ -8,6 +8,7 @@
 #include "dbustartmanager.h"
 #include "appsmanager.h"
 #include "appslistmodel.h"
+#include "latencyhistogram.h"
 
 #include <QVariant>
 #include <QProcess>
@@ -54,6 +55,8 @@ public:
     void creatMenuByAppItem();
     bool isMenuVisible();
 
+    static const LatencyHistogram &menuOpenLatency();
+
 signals:
     void appLaunched();
     void menuAccepted();
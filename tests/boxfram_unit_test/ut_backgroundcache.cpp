@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundcache.h"
+
+#include <QDir>
+#include <QFile>
+#include <QImage>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_BackgroundCache : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        // 缓存写入测试目录, 不影响用户的缓存
+        QStandardPaths::setTestModeEnabled(true);
+        QDir(BackgroundCache::cacheDir()).removeRecursively();
+    }
+
+    void TearDown() override
+    {
+        QDir(BackgroundCache::cacheDir()).removeRecursively();
+        QStandardPaths::setTestModeEnabled(false);
+    }
+};
+
+TEST_F(Tst_BackgroundCache, wallpaperId_test)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString wallpaper = dir.filePath("wallpaper.jpg");
+    QFile file(wallpaper);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("wallpaper");
+    file.close();
+
+    const QSize size(1920, 1080);
+    const QString id = BackgroundCache::wallpaperId(1, "HDMI-1", wallpaper, size);
+    QCOMPARE(BackgroundCache::wallpaperId(1, "HDMI-1", wallpaper, size), id);
+
+    // 工作区、显示器或壁纸不同时使用不同的缓存
+    QVERIFY(BackgroundCache::wallpaperId(2, "HDMI-1", wallpaper, size) != id);
+    QVERIFY(BackgroundCache::wallpaperId(1, "eDP-1", wallpaper, size) != id);
+
+    // 分辨率或缩放比例变化后背景的像素大小不同, 同样使用不同的缓存
+    QVERIFY(BackgroundCache::wallpaperId(1, "HDMI-1", wallpaper, size * 2) != id);
+
+    QVERIFY(file.open(QIODevice::Append));
+    file.write(" modified");
+    file.close();
+    QVERIFY(BackgroundCache::wallpaperId(1, "HDMI-1", wallpaper, size) != id);
+
+    QVERIFY(BackgroundCache::fileName(id, BackgroundCache::Background) != BackgroundCache::fileName(id, BackgroundCache::BlurBackground));
+}
+
+TEST_F(Tst_BackgroundCache, save_test)
+{
+    QImage image(64, 36, QImage::Format_RGB32);
+    image.fill(Qt::darkBlue);
+
+    const QSize size(1920, 1080);
+    const QString oldId = BackgroundCache::wallpaperId(1, "HDMI-1", "/usr/share/backgrounds/old.jpg", size);
+    const QString newId = BackgroundCache::wallpaperId(1, "HDMI-1", "/usr/share/backgrounds/new.jpg", size);
+    const QString otherId = BackgroundCache::wallpaperId(2, "HDMI-1", "/usr/share/backgrounds/old.jpg", size);
+    const QString otherOutputId = BackgroundCache::wallpaperId(1, "HDMI-1-1", "/usr/share/backgrounds/old.jpg", size);
+
+    for (const QString &id : { oldId, newId, otherId, otherOutputId }) {
+        QVERIFY(!BackgroundCache::contains(id));
+        QVERIFY(BackgroundCache::save(BackgroundCache::fileName(id, BackgroundCache::Background), image));
+
+        // 只有全屏背景和模糊背景都存在时才使用缓存
+        QVERIFY(!BackgroundCache::contains(id));
+        QVERIFY(BackgroundCache::save(BackgroundCache::fileName(id, BackgroundCache::BlurBackground), image));
+        QVERIFY(BackgroundCache::contains(id));
+    }
+
+    QCOMPARE(QImage(BackgroundCache::fileName(newId, BackgroundCache::Background)).size(), image.size());
+
+    // 只删除同一工作区及显示器之前的壁纸的缓存
+    BackgroundCache::removeOutdated(1, "HDMI-1", newId);
+    QVERIFY(!BackgroundCache::contains(oldId));
+    QVERIFY(BackgroundCache::contains(newId));
+    QVERIFY(BackgroundCache::contains(otherId));
+
+    // 显示器名称以该显示器名称开头时同样不删除
+    QVERIFY(BackgroundCache::contains(otherOutputId));
+}
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "backgroundimageloader.h"
+
+#include <QImage>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_BackgroundImageLoader : public testing::Test
+{};
+
+TEST_F(Tst_BackgroundImageLoader, read_test)
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.filePath("background.png");
+    QImage source(400, 300, QImage::Format_RGB32);
+    source.fill(Qt::darkCyan);
+    QVERIFY(source.save(fileName));
+
+    // 大于目标大小时按比例缩小, 铺满目标大小
+    QCOMPARE(BackgroundImageLoader::read(fileName, QSize(100, 100)).size(), QSize(133, 100));
+
+    // 小于目标大小时放大
+    QCOMPARE(BackgroundImageLoader::read(fileName, QSize(1000, 1000)).size(), QSize(1333, 1000));
+
+    // 目标大小为空时不缩放
+    QCOMPARE(BackgroundImageLoader::read(fileName, QSize()).size(), source.size());
+
+    QVERIFY(BackgroundImageLoader::read(dir.filePath("none.png"), QSize(100, 100)).isNull());
+}
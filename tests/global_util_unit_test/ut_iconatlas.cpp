@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconatlas.h"
+
+#include <QFile>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_IconAtlas : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_atlas = IconAtlas::instance();
+        m_defaultFilePath = m_atlas->filePath();
+
+        m_desktop = m_tempDir.path() + "/test.desktop";
+        QFile desktopFile(m_desktop);
+        desktopFile.open(QIODevice::WriteOnly);
+        desktopFile.write("[Desktop Entry]\nName=test\n");
+        desktopFile.close();
+
+        m_atlas->load(m_tempDir.path() + "/icon-atlas.cache");
+    }
+
+    void TearDown() override
+    {
+        m_atlas->load(m_defaultFilePath);
+    }
+
+public:
+    IconAtlas *m_atlas;
+    QTemporaryDir m_tempDir;
+    QString m_defaultFilePath;
+    QString m_desktop;
+};
+
+TEST_F(Tst_IconAtlas, saveAndLoad_test)
+{
+    QImage image(48, 48, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+
+    const QString key = m_desktop + "|test|64|1|";
+    m_atlas->insert(key, m_desktop, image, 1.0);
+    QVERIFY(m_atlas->save());
+
+    // 重新映射后从磁盘中读取
+    QVERIFY(m_atlas->load(m_atlas->filePath()));
+    QCOMPARE(m_atlas->count(), 1);
+
+    QPixmap pixmap;
+    QVERIFY(m_atlas->find(key, m_desktop, pixmap));
+    QCOMPARE(pixmap.size(), image.size());
+    QCOMPARE(pixmap.toImage().pixelColor(10, 10), QColor(Qt::red));
+
+    // 移除后写入磁盘, 再次加载时不存在
+    m_atlas->removeItem(m_desktop);
+    QVERIFY(m_atlas->save());
+    QVERIFY(!m_atlas->find(key, m_desktop, pixmap));
+    QCOMPARE(m_atlas->count(), 0);
+}
+
+TEST_F(Tst_IconAtlas, pixmapOutlivesMapping_test)
+{
+    QImage image(48, 48, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::red);
+
+    const QString key = m_desktop + "|test|64|1|";
+    m_atlas->insert(key, m_desktop, image, 1.0);
+    QVERIFY(m_atlas->save());
+
+    QPixmap pixmap;
+    QVERIFY(m_atlas->find(key, m_desktop, pixmap));
+
+    // 再次写入后旧的映射被释放, 之前取出的图标仍然可以绘制
+    QImage otherImage(32, 32, QImage::Format_ARGB32_Premultiplied);
+    otherImage.fill(Qt::blue);
+    m_atlas->insert(m_desktop + "|test|32|1|", m_desktop, otherImage, 1.0);
+    QVERIFY(m_atlas->save());
+
+    QImage target(48, 48, QImage::Format_ARGB32_Premultiplied);
+    target.fill(Qt::transparent);
+    QPainter painter(&target);
+    painter.drawPixmap(0, 0, pixmap);
+    painter.end();
+
+    QCOMPARE(target.pixelColor(10, 10), QColor(Qt::red));
+}
+
+TEST_F(Tst_IconAtlas, invalidFile_test)
+{
+    QFile file(m_atlas->filePath());
+    file.open(QIODevice::WriteOnly);
+    file.write(QByteArray(64, 'x'));
+    file.close();
+
+    QVERIFY(!m_atlas->load(m_atlas->filePath()));
+    QCOMPARE(m_atlas->count(), 0);
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "iconcachemanager.h"
+#include "util.h"
+
+#include <QPixmap>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_IconCacheManager : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_cacheManager = IconCacheManager::instance();
+        m_cacheManager->clear();
+    }
+
+public:
+    IconCacheManager *m_cacheManager;
+};
+
+TEST_F(Tst_IconCacheManager, findAndInsert_test)
+{
+    ItemInfo_v1 info;
+    info.m_desktop = "/usr/share/applications/dde-file-manager.desktop";
+    info.m_iconKey = "dde-file-manager";
+
+    const QString key = cacheKey(info, 48, 1.0);
+    QPixmap pixmap;
+    const quint64 missCount = m_cacheManager->missCount();
+    QVERIFY(!m_cacheManager->find(key, pixmap));
+    QCOMPARE(m_cacheManager->missCount(), missCount + 1);
+
+    QPixmap icon(64, 64);
+    icon.fill(Qt::red);
+    m_cacheManager->insert(key, icon);
+
+    const quint64 hitCount = m_cacheManager->hitCount();
+    QVERIFY(m_cacheManager->find(key, pixmap));
+    QCOMPARE(m_cacheManager->hitCount(), hitCount + 1);
+    QCOMPARE(pixmap.size(), icon.size());
+
+    // 同一应用不同尺寸共用一个 desktop 前缀, 移除时一并清除
+    const QString largeKey = cacheKey(info, 96, 1.0);
+    m_cacheManager->insert(largeKey, icon);
+    m_cacheManager->removeItem(info.m_desktop);
+    QVERIFY(!m_cacheManager->find(key, pixmap));
+    QVERIFY(!m_cacheManager->find(largeKey, pixmap));
+}
+
+TEST_F(Tst_IconCacheManager, costLimit_test)
+{
+    const int costLimit = m_cacheManager->costLimit();
+    QPixmap icon(64, 64);
+    icon.fill(Qt::red);
+    const int iconCost = icon.width() * icon.height() * icon.depth() / 8;
+
+    // 超出字节上限时淘汰最久未使用的图标
+    m_cacheManager->setCostLimit(iconCost * 2);
+    m_cacheManager->insert("a|", icon);
+    m_cacheManager->insert("b|", icon);
+    m_cacheManager->insert("c|", icon);
+
+    QPixmap pixmap;
+    QVERIFY(!m_cacheManager->find("a|", pixmap));
+    QVERIFY(m_cacheManager->find("c|", pixmap));
+    QVERIFY(m_cacheManager->totalCost() <= iconCost * 2);
+
+    // 空图标不缓存
+    m_cacheManager->insert("d|", QPixmap());
+    QVERIFY(!m_cacheManager->find("d|", pixmap));
+
+    m_cacheManager->setCostLimit(costLimit);
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "latencyhistogram.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_LatencyHistogram : public testing::Test
+{
+};
+
+TEST_F(Tst_LatencyHistogram, record_test)
+{
+    LatencyHistogram histogram(4);
+    QCOMPARE(histogram.bucketCount(), 4);
+    QCOMPARE(histogram.percentile(0.5), qint64(0));
+
+    // 区间为 [0, 1) [1, 2) [2, 4) [4, +∞) 毫秒
+    histogram.record(500);
+    histogram.record(1000);
+    histogram.record(3999);
+    histogram.record(4000);
+    histogram.record(100000);
+
+    QCOMPARE(histogram.count(), 5);
+    QCOMPARE(histogram.bucketValue(0), 1);
+    QCOMPARE(histogram.bucketValue(1), 1);
+    QCOMPARE(histogram.bucketValue(2), 1);
+    QCOMPARE(histogram.bucketValue(3), 2);
+
+    QCOMPARE(histogram.percentile(0.2), qint64(1));
+    QCOMPARE(histogram.percentile(0.6), qint64(4));
+    QCOMPARE(histogram.percentile(0.95), qint64(-1));
+    QCOMPARE(histogram.toString(), QString("<1ms:1 <2ms:1 <4ms:1 >=4ms:2"));
+
+    histogram.reset();
+    QCOMPARE(histogram.count(), 0);
+    QCOMPARE(histogram.bucketValue(3), 0);
+}
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchkernel.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_SearchKernel : public testing::Test
+{
+public:
+    static int kernelIndexOf(const QString &haystack, const QString &needle, const int from, const SearchKernel::Implementation implementation)
+    {
+        return SearchKernel::indexOf(haystack.utf16(), haystack.size(), needle.utf16(), needle.size(), from, implementation);
+    }
+
+    // 模拟 1000 个应用的搜索文本
+    static QStringList appSearchTexts()
+    {
+        QStringList texts;
+        for (int i = 0; i < 1000; ++i) {
+            texts << QString("Application %1 Viewer\norg.deepin.app%1\norg.deepin.app%1\nyingyong%1\nyy%1\nUtility;Office;Viewer;").arg(i);
+        }
+
+        return texts;
+    }
+};
+
+TEST_F(Tst_SearchKernel, indexOf_test)
+{
+    const QString haystack = QString("org.deepin.browser\nliu lan qi\nweb;internet;").repeated(3);
+    const QStringList needles = { "o", "browser", "internet;", "web;internet;org", "lan qi\nweb", "none", "" };
+
+    for (int implementation = SearchKernel::Scalar; implementation <= SearchKernel::AVX2; ++implementation) {
+        if (!SearchKernel::isSupported(SearchKernel::Implementation(implementation)))
+            continue;
+
+        for (const QString &needle : needles) {
+            for (int from = 0; from <= haystack.size() + 1; ++from) {
+                const int expected = from > haystack.size() ? -1 : haystack.indexOf(needle, from);
+                QCOMPARE(kernelIndexOf(haystack, needle, from, SearchKernel::Implementation(implementation)), expected);
+            }
+        }
+    }
+
+    // 搜索内容比文本长
+    QCOMPARE(kernelIndexOf("abc", "abcd", 0, SearchKernel::bestImplementation()), -1);
+}
+
+/**
+ * 对比预先转换为小写后使用各实现查找与 QString::contains(Qt::CaseInsensitive) 的耗时, 仅输出结果, 不作为判断依据
+ */
+TEST_F(Tst_SearchKernel, benchmark_test)
+{
+    const QStringList texts = appSearchTexts();
+    QStringList lowerTexts;
+    for (const QString &text : texts)
+        lowerTexts << text.toLower();
+
+    const QStringList queries = { "v", "vi", "vie", "view", "viewe", "viewer", "office", "app99", "zzz" };
+    const int rounds = 20;
+
+    QElapsedTimer timer;
+    int containsHits = 0;
+    timer.start();
+    for (int round = 0; round < rounds; ++round) {
+        for (const QString &query : queries) {
+            for (const QString &text : texts)
+                containsHits += text.contains(query, Qt::CaseInsensitive);
+        }
+    }
+    const qint64 containsTime = timer.nsecsElapsed();
+
+    for (int implementation = SearchKernel::Scalar; implementation <= SearchKernel::AVX2; ++implementation) {
+        if (!SearchKernel::isSupported(SearchKernel::Implementation(implementation)))
+            continue;
+
+        int kernelHits = 0;
+        timer.restart();
+        for (int round = 0; round < rounds; ++round) {
+            for (const QString &query : queries) {
+                for (const QString &text : lowerTexts)
+                    kernelHits += kernelIndexOf(text, query, 0, SearchKernel::Implementation(implementation)) != -1;
+            }
+        }
+        const qint64 kernelTime = timer.nsecsElapsed();
+
+        QCOMPARE(kernelHits, containsHits);
+        qInfo() << "search kernel benchmark, implementation:" << implementation
+                << ", contains():" << containsTime / rounds / queries.size() << "ns per query"
+                << ", kernel:" << kernelTime / rounds / queries.size() << "ns per query";
+    }
+}
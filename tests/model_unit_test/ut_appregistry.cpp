@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appregistry.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_AppRegistry : public testing::Test
+{
+public:
+    static ItemInfo_v1 createInfo(const QString &name, const QString &key)
+    {
+        ItemInfo_v1 info;
+        info.m_desktop = QString("/usr/share/applications/%1.desktop").arg(name);
+        info.m_name = name;
+        info.m_key = key;
+        return info;
+    }
+
+    // 与 AppsManager 原有的逐个比较结果一致
+    static int linearIndexOf(const ItemInfoList_v1 &list, const ItemInfo_v1 &item)
+    {
+        for (int i = 0; i < list.size(); ++i) {
+            if (list.at(i).isSimilar(item))
+                return i;
+        }
+
+        return -1;
+    }
+};
+
+TEST_F(Tst_AppRegistry, indexOf_test)
+{
+    ItemInfoList_v1 list;
+    list << createInfo("browser", "browser") << createInfo("mail", "mail") << createInfo("music", "music");
+
+    AppRegistry registry(list);
+    for (const ItemInfo_v1 &info : list)
+        QCOMPARE(registry.indexOf(info), linearIndexOf(list, info));
+
+    QCOMPARE(registry.indexOf(list.at(1).m_desktop), 1);
+
+    // desktop 相同但其他属性不同时视为不同的应用
+    ItemInfo_v1 other = list.at(0);
+    other.m_iconKey = "other-icon";
+    QVERIFY(!registry.contains(other));
+
+    // 名称等不参与比较的属性变化不影响查找
+    list[0].m_name = "Web Browser";
+    QCOMPARE(registry.indexOf(list.at(0)), 0);
+
+    QVERIFY(!registry.contains(createInfo("terminal", "terminal")));
+}
+
+TEST_F(Tst_AppRegistry, stableId_test)
+{
+    ItemInfoList_v1 list;
+    list << createInfo("browser", "browser") << createInfo("mail", "mail");
+
+    AppRegistry registry(list);
+    const AppRegistry::AppId browserId = registry.id(list.at(0).m_desktop);
+    const AppRegistry::AppId mailId = registry.id(list.at(1).m_desktop);
+
+    // 排序后 id 不变, 行号更新
+    list.move(0, 1);
+    registry.reindex();
+    QCOMPARE(registry.id(list.at(1).m_desktop), browserId);
+    QCOMPARE(registry.row(browserId), 1);
+    QCOMPARE(registry.row(mailId), 0);
+
+    // 移除后 id 保留, 行号无效
+    list.removeFirst();
+    registry.reindex();
+    QCOMPARE(registry.row(mailId), -1);
+    QCOMPARE(registry.id(createInfo("mail", "mail").m_desktop), mailId);
+
+    list.append(createInfo("music", "music"));
+    registry.indexAppendedRow();
+    QCOMPARE(registry.indexOf(list.last()), list.size() - 1);
+}
+
+TEST_F(Tst_AppRegistry, removedRow_test)
+{
+    ItemInfoList_v1 list;
+    list << createInfo("browser", "browser") << createInfo("mail", "office") << createInfo("music", "music")
+         << createInfo("writer", "office") << createInfo("terminal", "terminal");
+
+    AppRegistry registry(list);
+    const AppRegistry::AppId mailId = registry.id(list.at(1).m_desktop);
+
+    // 删除中间一行, 之后的行号前移, 共用的 key 由后面的应用代替
+    const ItemInfo_v1 removed = list.takeAt(1);
+    registry.indexRemovedRow(1, removed.m_desktop, removed.m_key);
+
+    QCOMPARE(registry.row(mailId), -1);
+    QCOMPARE(registry.id(removed.m_desktop), mailId);
+    QCOMPARE(registry.indexOfKey("office"), 2);
+
+    for (const ItemInfo_v1 &info : list)
+        QCOMPARE(registry.indexOf(info), linearIndexOf(list, info));
+
+    // 与重新建立的索引一致
+    AppRegistry rebuilt(list);
+    QCOMPARE(registry.indexOfKey("terminal"), rebuilt.indexOfKey("terminal"));
+    QCOMPARE(registry.indexOfKey("office"), rebuilt.indexOfKey("office"));
+}
+
+TEST_F(Tst_AppRegistry, duplicate_test)
+{
+    ItemInfoList_v1 list;
+    ItemInfo_v1 oldInfo = createInfo("browser", "browser");
+    oldInfo.m_iconKey = "old-icon";
+    ItemInfo_v1 newInfo = createInfo("browser", "browser");
+    newInfo.m_iconKey = "new-icon";
+    list << oldInfo << createInfo("mail", "browser") << newInfo;
+
+    AppRegistry registry(list);
+    QCOMPARE(registry.indexOf(newInfo), linearIndexOf(list, newInfo));
+    QCOMPARE(registry.indexOf(oldInfo), linearIndexOf(list, oldInfo));
+
+    // 同一个 key 对应多个应用时返回第一个
+    QCOMPARE(registry.indexOfKey("browser"), 0);
+    QCOMPARE(registry.indexOfKey("none"), -1);
+}
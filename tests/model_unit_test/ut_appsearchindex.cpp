@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appsearchindex.h"
+
+#include <QDateTime>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_AppSearchIndex : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_searchIndex = AppSearchIndex::instance();
+
+        m_info.m_desktop = "/usr/share/applications/org.deepin.browser.desktop";
+        m_info.m_name = "Browser";
+        m_info.m_key = "org.deepin.browser";
+        m_info.m_keywords << "Internet" << "WWW";
+
+        m_searchIndex->rebuild(ItemInfoList_v1() << m_info);
+    }
+
+public:
+    AppSearchIndex *m_searchIndex;
+    ItemInfo_v1 m_info;
+};
+
+TEST_F(Tst_AppSearchIndex, score_test)
+{
+    QCOMPARE(m_searchIndex->count(), 1);
+
+    // 名称、key、desktop 文件名及关键字均参与匹配, 不区分大小写
+    QVERIFY(m_searchIndex->score(m_info.m_desktop, "brow") > AppSearchIndex::NoMatch);
+    QVERIFY(m_searchIndex->score(m_info.m_desktop, "deepin.browser") > AppSearchIndex::NoMatch);
+    QVERIFY(m_searchIndex->score(m_info.m_desktop, "www") > AppSearchIndex::NoMatch);
+    QCOMPARE(m_searchIndex->score(m_info.m_desktop, "applications"), int(AppSearchIndex::NoMatch));
+    QCOMPARE(m_searchIndex->score(m_info.m_desktop, "terminal"), int(AppSearchIndex::NoMatch));
+
+    // 不跨字段匹配
+    QCOMPARE(m_searchIndex->score(m_info.m_desktop, "internetwww"), int(AppSearchIndex::NoMatch));
+}
+
+TEST_F(Tst_AppSearchIndex, matchScore_test)
+{
+    const QString text = "text editor\ntext-editor";
+
+    // 前缀 > 单词开头 > 子串 > 子序列 > 单个错字
+    const int prefixScore = AppSearchIndex::matchScore(text, "text");
+    const int wordScore = AppSearchIndex::matchScore(text, "editor");
+    const int substringScore = AppSearchIndex::matchScore(text, "dito");
+    const int subsequenceScore = AppSearchIndex::matchScore(text, "txed");
+    const int typoScore = AppSearchIndex::matchScore(text, "edotor");
+
+    QVERIFY(prefixScore > wordScore);
+    QVERIFY(wordScore > substringScore);
+    QVERIFY(substringScore > subsequenceScore);
+    QVERIFY(subsequenceScore > typoScore);
+    QVERIFY(typoScore > AppSearchIndex::NoMatch);
+
+    // 搜索内容过短时不做容错
+    QCOMPARE(AppSearchIndex::matchScore(text, "xyz"), int(AppSearchIndex::NoMatch));
+}
+
+TEST_F(Tst_AppSearchIndex, usageScore_test)
+{
+    const qlonglong currentTime = QDateTime::currentMSecsSinceEpoch() / 1000;
+
+    QCOMPARE(AppSearchIndex::usageScore(0, 0), 0);
+    QVERIFY(AppSearchIndex::usageScore(10, currentTime) > AppSearchIndex::usageScore(10, currentTime - 100 * 3600));
+
+    // 使用频率加分不超过两档匹配之间的差值
+    QVERIFY(AppSearchIndex::usageScore(100000, currentTime) < AppSearchIndex::WordMatch - AppSearchIndex::SubstringMatch);
+}
+
+TEST_F(Tst_AppSearchIndex, update_test)
+{
+    ItemInfo_v1 info = m_info;
+    info.m_name = "Web Browser";
+    m_searchIndex->update(info);
+    QVERIFY(m_searchIndex->score(info.m_desktop, "web") > AppSearchIndex::NoMatch);
+
+    m_searchIndex->remove(info.m_desktop);
+    QVERIFY(!m_searchIndex->contains(info.m_desktop));
+
+    // 不在索引中的应用临时生成搜索文本
+    QVERIFY(m_searchIndex->score(info, "web") > AppSearchIndex::NoMatch);
+}
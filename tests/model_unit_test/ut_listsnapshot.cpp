@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "listsnapshot.h"
+
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_ListSnapshot : public testing::Test
+{
+public:
+    static ItemInfo_v1 createInfo(const QString &name, const qlonglong openCount)
+    {
+        ItemInfo_v1 info;
+        info.m_desktop = QString("/usr/share/applications/%1.desktop").arg(name);
+        info.m_name = name;
+        info.m_key = name;
+        info.m_iconKey = name;
+        info.m_description = QString("描述 %1").arg(name);
+        info.m_categoryId = 3;
+        info.m_installedTime = 1690000000;
+        info.m_openCount = openCount;
+        info.m_firstRunTime = 1690003600;
+        return info;
+    }
+
+    static ListSnapshot::Lists createLists()
+    {
+        ItemInfo_v1 dir = createInfo("folder", 0);
+        dir.m_isDir = true;
+        dir.m_appInfoList << createInfo("mail", 2) << createInfo("music", 5);
+
+        ItemInfoList_v1 fullscreenList;
+        fullscreenList << createInfo("browser", 10) << dir << createInfo("terminal", 1);
+
+        ItemInfoList_v1 categoryList;
+        categoryList << createInfo("browser", 10);
+
+        ListSnapshot::Lists lists;
+        lists.insert("lists", fullscreenList);
+        lists.insert("lists_4", categoryList);
+        lists.insert("lists_5", ItemInfoList_v1());
+        return lists;
+    }
+
+    // 快照只保存 desktop、文件夹名称、文件夹内的应用及使用次数
+    static void compareInfo(const ItemInfo_v1 &actual, const ItemInfo_v1 &expected)
+    {
+        QCOMPARE(actual.m_desktop, expected.m_desktop);
+        QCOMPARE(actual.m_name, expected.m_isDir ? expected.m_name : QString());
+        QVERIFY(actual.m_key.isEmpty());
+        QVERIFY(actual.m_iconKey.isEmpty());
+        QCOMPARE(actual.m_openCount, expected.m_openCount);
+        QCOMPARE(actual.m_firstRunTime, expected.m_firstRunTime);
+        QCOMPARE(actual.m_isDir, expected.m_isDir);
+        QCOMPARE(actual.m_appInfoList.size(), expected.m_appInfoList.size());
+
+        for (int i = 0; i < expected.m_appInfoList.size(); ++i)
+            compareInfo(actual.m_appInfoList.at(i), expected.m_appInfoList.at(i));
+    }
+
+    static bool decode(const QByteArray &data, ListSnapshot::Lists &lists)
+    {
+        return ListSnapshot::decode(reinterpret_cast<const uchar *>(data.constData()), data.size(), lists);
+    }
+};
+
+TEST_F(Tst_ListSnapshot, roundTrip_test)
+{
+    const ListSnapshot::Lists lists = createLists();
+    const QByteArray data = ListSnapshot::encode(lists);
+
+    ListSnapshot::Lists decoded;
+    QVERIFY(decode(data, decoded));
+    QCOMPARE(decoded.keys().toSet(), lists.keys().toSet());
+
+    for (auto it = lists.constBegin(); it != lists.constEnd(); ++it) {
+        const ItemInfoList_v1 list = decoded.value(it.key());
+        QCOMPARE(list.size(), it.value().size());
+
+        for (int i = 0; i < list.size(); ++i)
+            compareInfo(list.at(i), it.value().at(i));
+    }
+
+    // 不含数据时也是有效的快照
+    QVERIFY(decode(ListSnapshot::encode(ListSnapshot::Lists()), decoded));
+    QVERIFY(decoded.isEmpty());
+}
+
+TEST_F(Tst_ListSnapshot, invalid_test)
+{
+    const ListSnapshot::Lists lists = createLists();
+    const QByteArray data = ListSnapshot::encode(lists);
+
+    ListSnapshot::Lists decoded = lists;
+
+    // 数据被修改时校验失败, 且不修改原有的列表
+    QByteArray corrupted = data;
+    corrupted[corrupted.size() - 1] = char(corrupted.at(corrupted.size() - 1) ^ 0x01);
+    QVERIFY(!decode(corrupted, decoded));
+    QCOMPARE(decoded.size(), lists.size());
+
+    // 文件不完整
+    QVERIFY(!decode(data.left(data.size() - 2), decoded));
+    QVERIFY(!decode(data.left(16), decoded));
+    QVERIFY(!ListSnapshot::decode(nullptr, 0, decoded));
+
+    // 版本不同
+    QByteArray otherVersion = data;
+    otherVersion[4] = char(ListSnapshot::Version + 1);
+    QVERIFY(!decode(otherVersion, decoded));
+
+    QCOMPARE(decoded.size(), lists.size());
+}
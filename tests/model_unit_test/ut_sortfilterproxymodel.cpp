@@ -0,0 +1,83 @@
+// SPDX-FileCopyrightText: 2023 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "sortfilterproxymodel.h"
+#include "appsearchindex.h"
+#include "appslistmodel.h"
+
+#include <QStandardItemModel>
+#include <QTest>
+
+#include <gtest/gtest.h>
+
+class Tst_SortFilterProxyModel : public testing::Test
+{
+public:
+    void SetUp() override
+    {
+        m_info.m_desktop = "/usr/share/applications/abxd.desktop";
+        m_info.m_name = "Abxd";
+        m_info.m_key = "abxd";
+
+        AppSearchIndex::instance()->rebuild(ItemInfoList_v1() << m_info);
+
+        QStandardItem *item = new QStandardItem;
+        item->setData(m_info.m_desktop, AppsListModel::AppDesktopRole);
+        m_sourceModel.appendRow(item);
+
+        m_proxyModel.setSourceModel(&m_sourceModel);
+    }
+
+    void TearDown() override
+    {
+        AppSearchIndex::instance()->rebuild(ItemInfoList_v1());
+    }
+
+public:
+    ItemInfo_v1 m_info;
+    QStandardItemModel m_sourceModel;
+    SortFilterProxyModel m_proxyModel;
+};
+
+TEST_F(Tst_SortFilterProxyModel, narrowing_test)
+{
+    m_proxyModel.setSearchText("ab");
+    QCOMPARE(m_proxyModel.rowCount(), 1);
+
+    m_proxyModel.setSearchText("abx");
+    QCOMPARE(m_proxyModel.rowCount(), 1);
+
+    m_proxyModel.setSearchText("abxz");
+    QCOMPARE(m_proxyModel.rowCount(), 1);
+
+    m_proxyModel.setSearchText("abxzz");
+    QCOMPARE(m_proxyModel.rowCount(), 0);
+}
+
+TEST_F(Tst_SortFilterProxyModel, typoLength_test)
+{
+    m_proxyModel.setSearchText("abc");
+    QCOMPARE(m_proxyModel.rowCount(), 0);
+
+    // 长度达到容错匹配的最小长度时出现新的结果, 不能只在上一次的结果中筛选
+    m_proxyModel.setSearchText("abcd");
+    QCOMPARE(m_proxyModel.rowCount(), 1);
+
+    QVERIFY(!AppSearchIndex::isNarrowing("abc", "abcd"));
+    QVERIFY(AppSearchIndex::isNarrowing("abcd", "abcde"));
+    QVERIFY(AppSearchIndex::isNarrowing("a", "abc"));
+}
+
+TEST_F(Tst_SortFilterProxyModel, dataChanged_test)
+{
+    m_proxyModel.setSearchText("brow");
+    QCOMPARE(m_proxyModel.rowCount(), 0);
+
+    // 应用改名后只通知数据变化, 按新的名称匹配
+    ItemInfo_v1 info = m_info;
+    info.m_name = "Browser";
+    AppSearchIndex::instance()->update(info);
+    m_sourceModel.item(0)->setData(info.m_name, AppsListModel::AppNameRole);
+    QCOMPARE(m_proxyModel.rowCount(), 1);
+}